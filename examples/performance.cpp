@@ -37,6 +37,7 @@
  * POSSIBILITY OF SUCH DAMAGE.
  * */
 
+#include <algorithm>
 #include <chrono>
 #include <iostream>
 #include <fstream>
@@ -46,32 +47,46 @@ using namespace std;
 
 static const size_t TEST_COUNT = 100;
 
+static long measure_parsing(const std::string& to_parse) {
+    auto start_time = chrono::steady_clock::now();
+    for (size_t i = 0; i < TEST_COUNT; ++i) {
+        json::Value value;
+        json::Deserializer(to_parse) >> value;
+    }
+    auto end_time = chrono::steady_clock::now();
+    auto us = chrono::duration_cast<chrono::microseconds>(
+            end_time - start_time);
+
+    return us.count() / long(TEST_COUNT);
+}
+
 int main(int argc, char* argv[]) {
     if (argc < 2) {
         return -1;
     }
 
-    ifstream inputfile(argv[1]);
-    std::string to_parse;
+    for (int i = 1; i < argc; ++i) {
+        ifstream inputfile(argv[i]);
+        std::string to_parse;
 
-    inputfile.seekg(0, std::ios::end);
-    to_parse.reserve(size_t(inputfile.tellg()));
-    inputfile.seekg(0, std::ios::beg);
+        inputfile.seekg(0, std::ios::end);
+        to_parse.reserve(size_t(inputfile.tellg()));
+        inputfile.seekg(0, std::ios::beg);
 
-    to_parse.assign((std::istreambuf_iterator<char>(inputfile)),
-                                 std::istreambuf_iterator<char>());
+        to_parse.assign((std::istreambuf_iterator<char>(inputfile)),
+                                     std::istreambuf_iterator<char>());
 
-    cout << "Start parsing" << endl;
+        size_t whitespaces = size_t(std::count_if(to_parse.cbegin(),
+                    to_parse.cend(), [] (char ch) {
+                        return (' ' == ch) || ('\t' == ch) ||
+                            ('\n' == ch) || ('\r' == ch);
+                    }));
 
-    auto start_time = chrono::steady_clock::now();
-    for (size_t i = 0; i < TEST_COUNT; ++i) {
-        json::Value value;
-        json::Deserializer(to_parse) >> value;
-    }
-    auto end_time = chrono::steady_clock::now();
-    auto us = chrono::duration_cast<chrono::microseconds>(
-            end_time - start_time);
+        cout << "Start parsing " << argv[i] << " ("
+             << (100 * whitespaces / std::max<size_t>(1, to_parse.size()))
+             << "% whitespaces)" << endl;
 
-    cout << "[+] Finished successfully with an average of: "
-         << (us.count() / long(TEST_COUNT)) << " us\n" << endl;
+        cout << "[+] Finished successfully with an average of: "
+             << measure_parsing(to_parse) << " us\n" << endl;
+    }
 }
@@ -0,0 +1,94 @@
+/*!
+ * @copyright
+ * Copyright (c) 2015, Tymoteusz Blazejczyk
+ *
+ * @copyright
+ * All rights reserved.
+ *
+ * @copyright
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * @copyright
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * @copyright
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * @copyright
+ * * Neither the name of json-cxx nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * @copyright
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#include <chrono>
+#include <random>
+#include <string>
+#include <iostream>
+#include "json/json.hpp"
+
+using namespace std;
+
+static const size_t TEST_COUNT = 100;
+static const size_t NUMBERS_COUNT = 100000;
+
+/*!
+ * @brief Create JSON array with random integers of all magnitudes
+ * */
+template<typename T>
+static json::Value generate_integers() {
+    mt19937_64 generator(0);
+    string str{"["};
+
+    for (size_t i = 0; i < NUMBERS_COUNT; ++i) {
+        uint64_t bits = generator() >> (generator() % 64);
+        if (i) { str += ','; }
+        str += to_string(T(bits));
+    }
+    str += ']';
+
+    json::Value value;
+    json::Deserializer(str) >> value;
+
+    return value;
+}
+
+static long measure_serialization(const json::Value& value) {
+    auto start_time = chrono::steady_clock::now();
+    for (size_t i = 0; i < TEST_COUNT; ++i) {
+        json::Serializer serializer(value);
+    }
+    auto end_time = chrono::steady_clock::now();
+    auto us = chrono::duration_cast<chrono::microseconds>(
+            end_time - start_time);
+
+    return us.count() / long(TEST_COUNT);
+}
+
+int main() {
+    cout << "Start serializing " << NUMBERS_COUNT << " Uint64 numbers" << endl;
+    cout << "[+] Finished successfully with an average of: "
+         << measure_serialization(generate_integers<json::Uint64>())
+         << " us\n" << endl;
+
+    cout << "Start serializing " << NUMBERS_COUNT << " Int64 numbers" << endl;
+    cout << "[+] Finished successfully with an average of: "
+         << measure_serialization(generate_integers<json::Int64>())
+         << " us\n" << endl;
+}
@@ -0,0 +1,166 @@
+/*!
+ * @copyright
+ * Copyright (c) 2015, Tymoteusz Blazejczyk
+ *
+ * @copyright
+ * All rights reserved.
+ *
+ * @copyright
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * @copyright
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * @copyright
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * @copyright
+ * * Neither the name of json-cxx nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * @copyright
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file json/arena.hpp
+ *
+ * @brief JSON arena interface
+ * */
+
+#ifndef JSON_CXX_ARENA_HPP
+#define JSON_CXX_ARENA_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace json {
+
+/*!
+ * @brief Monotonic memory arena
+ *
+ * Memory is allocated by bumping pointer in chunks and it is never freed
+ * separately. All allocations are released at once with clear() or when
+ * arena is destroyed. Objects created in arena must be trivially
+ * destructible. First chunk may be caller-supplied buffer, next chunks
+ * are allocated from heap with growing size
+ * */
+class Arena {
+public:
+    /*! Default size of first heap chunk */
+    static constexpr std::size_t DEFAULT_CHUNK_SIZE{65536};
+
+    /*!
+     * @brief Create empty arena
+     *
+     * @param[in]   chunk_size  Size of first heap chunk
+     * */
+    Arena(std::size_t chunk_size = DEFAULT_CHUNK_SIZE);
+
+    /*!
+     * @brief Create arena that uses caller-supplied buffer first
+     *
+     * Buffer is not owned by arena and it must outlive arena
+     *
+     * @param[in]   buffer      Memory buffer
+     * @param[in]   size        Buffer size in bytes
+     * @param[in]   chunk_size  Size of first heap chunk
+     * */
+    Arena(void* buffer, std::size_t size,
+            std::size_t chunk_size = DEFAULT_CHUNK_SIZE);
+
+    /*!
+     * @brief Allocate memory
+     *
+     * @param[in]   size        Size in bytes
+     * @param[in]   alignment   Alignment, must be power of two
+     *
+     * @return  Allocated memory
+     * */
+    void* allocate(std::size_t size, std::size_t alignment) {
+        std::size_t padding = (alignment -
+                (reinterpret_cast<std::uintptr_t>(m_current) &
+                 (alignment - 1))) & (alignment - 1);
+
+        if ((padding + size) > std::size_t(m_end - m_current)) {
+            return allocate_chunk(size, alignment);
+        }
+
+        void* ptr = m_current + padding;
+        m_current += padding + size;
+        return ptr;
+    }
+
+    /*!
+     * @brief Allocate memory for array of objects
+     *
+     * Objects are not constructed
+     *
+     * @param[in]   count   Number of objects
+     *
+     * @return  Allocated memory
+     * */
+    template<typename T>
+    T* allocate(std::size_t count) {
+        return static_cast<T*>(allocate(count * sizeof(T), alignof(T)));
+    }
+
+    /*!
+     * @brief Release all allocations at once
+     *
+     * Caller-supplied buffer and heap memory are kept for reuse. Many heap
+     * chunks are replaced with single chunk of the same total size, so the
+     * same allocations after clear() don't use heap again
+     * */
+    void clear();
+
+    /*!
+     * @brief Get number of bytes obtained from heap
+     *
+     * @return  Size of all heap chunks in bytes
+     * */
+    std::size_t get_heap_size() const {
+        return m_heap_size;
+    }
+
+    ~Arena();
+private:
+    Arena(const Arena&) = delete;
+    Arena(Arena&&) = delete;
+    Arena& operator=(const Arena&) = delete;
+    Arena& operator=(Arena&&) = delete;
+
+    struct Chunk;
+
+    void* allocate_chunk(std::size_t size, std::size_t alignment);
+
+    void free_chunks();
+
+    char* m_current;
+    char* m_end;
+    char* m_buffer;
+    std::size_t m_buffer_size;
+    /*! Heap chunks list, the most recent one first */
+    Chunk* m_chunks;
+    /*! Kept heap chunk that is not used yet after clear() */
+    Chunk* m_spare;
+    std::size_t m_chunk_size;
+    std::size_t m_heap_size;
+};
+
+}
+
+#endif /* JSON_CXX_ARENA_HPP */
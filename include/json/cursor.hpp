@@ -0,0 +1,216 @@
+/*!
+ * @copyright
+ * Copyright (c) 2015, Tymoteusz Blazejczyk
+ *
+ * @copyright
+ * All rights reserved.
+ *
+ * @copyright
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * @copyright
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * @copyright
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * @copyright
+ * * Neither the name of json-cxx nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * @copyright
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file cursor.hpp
+ *
+ * @brief JSON on-demand cursor interface
+ * */
+
+#ifndef JSON_CXX_CURSOR_HPP
+#define JSON_CXX_CURSOR_HPP
+
+#include <json/value.hpp>
+#include <json/deserializer_error.hpp>
+
+#include <string>
+#include <cstring>
+
+namespace json {
+
+/*!
+ * @brief Read-only, on-demand view of JSON text
+ *
+ * Cursor points to single JSON value in JSON text and doesn't build any
+ * JSON tree. Accessing object member or array element scans JSON text
+ * directly and skips unneeded values by brackets matching, without
+ * parsing them. Only accessed scalars and values converted with
+ * to_value() are fully parsed and validated.
+ *
+ * Skipped values are checked only for brackets and strings, so invalid
+ * JSON text may be not detected. Errors are reported as DeserializerError
+ * with offset from JSON text beginning. JSON text must be kept unchanged
+ * as long as cursors are used
+ *
+ * @code
+ * json::Cursor cursor(payload);
+ * cursor["user"]["name"].as_string();
+ * @endcode
+ * */
+class Cursor {
+public:
+    using Type = Value::Type;
+
+    /*! Create cursor to missing value, behaves like JSON null */
+    Cursor();
+
+    /*!
+     * @brief Create cursor to root value of JSON text
+     *
+     * @param[in]   str     JSON text
+     * @param[in]   length  JSON text length
+     * */
+    Cursor(const char* str, std::size_t length);
+
+    Cursor(const char* str) : Cursor(str, std::strlen(str)) { }
+
+    Cursor(const std::string& str) : Cursor(str.data(), str.size()) { }
+
+    Cursor(const Cursor&) = default;
+    Cursor& operator=(const Cursor&) = default;
+
+    /*!
+     * @brief Get JSON type from the first value character
+     * */
+    Type get_type() const;
+
+    bool is_string() const { return Type::STRING == get_type(); }
+
+    bool is_object() const { return Type::OBJECT == get_type(); }
+
+    bool is_array() const { return Type::ARRAY == get_type(); }
+
+    bool is_number() const { return Type::NUMBER == get_type(); }
+
+    bool is_boolean() const { return Type::BOOLEAN == get_type(); }
+
+    bool is_null() const { return Type::NIL == get_type(); }
+
+    /*!
+     * @brief Check if cursor points to existing value
+     *
+     * @return  false for missing object member or array element
+     * */
+    bool is_valid() const { return nullptr != m_current; }
+
+    /*!
+     * @brief Get number of elements in JSON array or object
+     *
+     * Elements are counted by skipping them. For any others JSON types it
+     * returns always zero
+     * */
+    std::size_t size() const;
+
+    bool empty() const { return !size(); }
+
+    /*!
+     * @brief Access to JSON array element or JSON object member value
+     *
+     * Preceding elements are skipped. When index is out of range or
+     * cursor is neither array nor object, invalid cursor is returned
+     *
+     * @param[in]   index   Element index
+     * */
+    Cursor operator[](std::size_t index) const;
+
+    Cursor operator[](int index) const {
+        return (*this)[std::size_t(index)];
+    }
+
+    /*!
+     * @brief Access to JSON object member value
+     *
+     * Members are compared with given key in order. When member doesn't
+     * exist or cursor is not an object, invalid cursor is returned
+     *
+     * @param[in]   key     JSON object member key
+     * */
+    Cursor operator[](const char* key) const {
+        return find(key, std::strlen(key));
+    }
+
+    Cursor operator[](const String& key) const {
+        return find(key.data(), key.size());
+    }
+
+    bool is_member(const char* key) const {
+        return find(key, std::strlen(key)).is_valid();
+    }
+
+    bool is_member(const String& key) const {
+        return find(key.data(), key.size()).is_valid();
+    }
+
+    String as_string() const;
+
+    Bool as_bool() const;
+
+    Int as_int() const { return Int(as_number()); }
+
+    Uint as_uint() const { return Uint(as_number()); }
+
+    Int64 as_int64() const { return Int64(as_number()); }
+
+    Uint64 as_uint64() const { return Uint64(as_number()); }
+
+    Double as_double() const { return Double(as_number()); }
+
+    Number as_number() const;
+
+    /*!
+     * @brief Parse pointed value with all its elements to JSON value
+     *
+     * @return  JSON value, JSON null for invalid cursor
+     * */
+    Value to_value() const;
+private:
+    Cursor(const char* begin, const char* current, const char* end);
+
+    Cursor find(const char* key, std::size_t length) const;
+
+    const char* skip_value(const char* pos) const;
+    const char* skip_string(const char* pos) const;
+    const char* skip_container(const char* pos) const;
+    const char* skip_whitespaces(const char* pos) const;
+    const char* read_first(char close) const;
+    const char* read_key(const char* pos, const char** key,
+            std::size_t& length) const;
+    const char* read_separator(const char* pos, char close) const;
+
+    [[noreturn]] void throw_error(DeserializerError::Code code,
+            const char* pos) const;
+
+    /*! JSON text beginning, used for error offsets */
+    const char* m_begin;
+    /*! First character of pointed value, nullptr for missing value */
+    const char* m_current;
+    const char* m_end;
+};
+
+}
+
+#endif /* JSON_CXX_CURSOR_HPP */
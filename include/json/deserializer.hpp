@@ -45,14 +45,18 @@
 #define JSON_CXX_DESERIALIZER_HPP
 
 #include <json/value.hpp>
+#include <json/deserializer_error.hpp>
 
 #include <string>
 #include <cstring>
 #include <cstdint>
 #include <limits>
+#include <utility>
 
 namespace json {
 
+class Handler;
+
 /*!
  * @brief JSON deserialization from string stream contains JSON objects {} or
  * arrays [] to JSON C++ value
@@ -62,6 +66,18 @@ public:
     static constexpr const std::size_t DEFAULT_LIMIT_PER_OBJECT =
         std::numeric_limits<std::uint32_t>::max();
 
+    /*! Result of parsing that doesn't throw parsing errors */
+    struct Result {
+        /*! Parsing error code, NONE on success */
+        DeserializerError::Code code;
+        /*! Offset in JSON text where parsing failed */
+        std::size_t offset;
+
+        explicit operator bool() const {
+            return DeserializerError::NONE == code;
+        }
+    };
+
     /*!
      * @brief Default constructor
      *
@@ -176,11 +192,27 @@ public:
      *
      * @param[out]  value   JSON value to store from the stack
      * */
-    Deserializer& operator>>(Value& value) {
+    Deserializer& operator>>(Value& value) & {
         value = m_value;
         return *this;
     }
 
+    /*!
+     * @brief Pop parsed single JSON value from the temporary deserializer
+     *
+     * Parsed JSON value is moved out without a deep copy:
+     *
+     * @code
+     * json::Deserializer(str) >> value;
+     * @endcode
+     *
+     * @param[out]  value   JSON value to store from the stack
+     * */
+    Deserializer& operator>>(Value& value) && {
+        value = release();
+        return *this;
+    }
+
     void clear();
 
     /*!
@@ -197,12 +229,134 @@ public:
         m_limit = limit;
     }
 
+    /*!
+     * @brief Enable two-stage parsing with structural index
+     *
+     * Whole JSON text is first classified with SIMD instructions to index
+     * of tokens, next JSON value is built from that index. It is faster
+     * for large JSON texts with many whitespaces or long strings
+     *
+     * @param[in]   enable  Use structural index
+     * */
+    void set_structural_index(bool enable) {
+        m_structural_index = enable;
+    }
+
     const Value& get_value() const {
         return m_value;
     }
 
+    /*!
+     * @brief Move parsed JSON value out of the deserializer
+     *
+     * After that deserializer holds JSON null value
+     *
+     * @return  Parsed JSON value
+     * */
+    Value release() {
+        Value value(std::move(m_value));
+        m_value = nullptr;
+        return value;
+    }
+
     void parsing(const char* str, std::size_t length);
 
+    /*!
+     * @brief Parse JSON text directly into given JSON value
+     *
+     * Deserializer doesn't keep any copy of the parsed JSON value.
+     * On error given value is set to JSON null value
+     *
+     * @param[in]   str     String contains JSON objects {} or arrays [].
+     * @param[in]   length  Number of characters to parse
+     * @param[out]  value   JSON value to store result
+     * */
+    void parsing(const char* str, std::size_t length, Value& value);
+
+    void parsing(const std::string& str, Value& value) {
+        parsing(str.c_str(), str.length(), value);
+    }
+
+    void parsing(const char* str, Value& value) {
+        parsing(str, std::strlen(str), value);
+    }
+
+    /*!
+     * @brief Parse JSON text directly into given JSON value without
+     * throwing parsing errors
+     *
+     * Invalid JSON text is rejected as fast as valid one is accepted,
+     * no exception is created and unwound. Memory allocation failure is
+     * reported with OUT_OF_MEMORY code. On error given value is set to
+     * JSON null value
+     *
+     * @code
+     * if (!deserializer.try_parsing(str, value)) { ... }
+     * @endcode
+     *
+     * @param[in]   str     String contains JSON objects {} or arrays [].
+     * @param[in]   length  Number of characters to parse
+     * @param[out]  value   JSON value to store result
+     *
+     * @return  Error code and offset, NONE on success
+     * */
+    Result try_parsing(const char* str, std::size_t length,
+            Value& value) noexcept;
+
+    Result try_parsing(const std::string& str, Value& value) noexcept {
+        return try_parsing(str.c_str(), str.length(), value);
+    }
+
+    Result try_parsing(const char* str, Value& value) noexcept {
+        return try_parsing(str, std::strlen(str), value);
+    }
+
+    /*!
+     * @brief Check JSON text without building JSON value
+     *
+     * Same grammar and limits as parsing() are checked, additionally
+     * UTF-8 encoding of whole JSON text must be valid. Numbers are not
+     * converted and no JSON value is allocated. Like parsing(), empty
+     * JSON text or only whitespaces are accepted as JSON null value.
+     * Structural index and containers stack may still allocate, their
+     * allocation failure is reported with OUT_OF_MEMORY code
+     *
+     * @param[in]   str     String contains JSON objects {} or arrays [].
+     * @param[in]   length  Number of characters to check
+     *
+     * @return  Error code and offset, NONE when JSON text is valid
+     * */
+    Result validate(const char* str, std::size_t length) const noexcept;
+
+    Result validate(const std::string& str) const noexcept {
+        return validate(str.c_str(), str.length());
+    }
+
+    Result validate(const char* str) const noexcept {
+        return validate(str, std::strlen(str));
+    }
+
+    /*!
+     * @brief Parse JSON text and pass parsing events to given handler
+     *
+     * No JSON value is created and deserializer content is not changed.
+     * Memory usage doesn't depend on JSON text size, only on containers
+     * nesting. On error handler may already receive some events
+     *
+     * @param[in]   str     String contains JSON objects {} or arrays [].
+     * @param[in]   length  Number of characters to parse
+     * @param[in]   handler Parsing events handler
+     * */
+    void parsing(const char* str, std::size_t length, Handler& handler);
+
+    void parsing(const std::string& str, Handler& handler) {
+        parsing(str.c_str(), str.length(), handler);
+    }
+
+    void parsing(const char* str, Handler& handler) {
+        parsing(str, std::strlen(str), handler);
+    }
+
     void parsing(const std::string& str) {
         parsing(str.c_str(), str.length());
     }
@@ -215,9 +369,71 @@ public:
     void parsing(const char str[N]) {
         parsing(str, N - 1);
     }
+
+    /*!
+     * @brief Parse JSON file
+     *
+     * File is memory-mapped and parsed in place, without copying it to
+     * string first. Throws std::system_error when file cannot be read
+     *
+     * @param[in]   path    Path to JSON file
+     * */
+    void parsing_file(const char* path);
+
+    void parsing_file(const std::string& path) {
+        parsing_file(path.c_str());
+    }
+
+    /*!
+     * @brief Parse JSON file directly into given JSON value
+     *
+     * @param[in]   path    Path to JSON file
+     * @param[out]  value   JSON value to store result
+     * */
+    void parsing_file(const char* path, Value& value);
+
+    void parsing_file(const std::string& path, Value& value) {
+        parsing_file(path.c_str(), value);
+    }
+
+    /*!
+     * @brief Parse JSON file and pass parsing events to given handler
+     *
+     * @param[in]   path    Path to JSON file
+     * @param[in]   handler Parsing events handler
+     * */
+    void parsing_file(const char* path, Handler& handler);
+
+    void parsing_file(const std::string& path, Handler& handler) {
+        parsing_file(path.c_str(), handler);
+    }
 private:
     Value m_value = nullptr;
     std::size_t m_limit{DEFAULT_LIMIT_PER_OBJECT};
+    bool m_structural_index{false};
+};
+
+/*!
+ * @brief Result of JSON text extraction to JSON value
+ *
+ * Refers to the first extracted value, so chained extraction doesn't
+ * need deserializer that holds a copy of parsed JSON value
+ * */
+class Extraction {
+public:
+    explicit Extraction(const Value& value) : m_value(value) { }
+
+    /*!
+     * @brief Store copy of extracted JSON value
+     *
+     * @param[out]  value   JSON value to store
+     * */
+    const Extraction& operator>>(Value& value) const {
+        value = m_value;
+        return *this;
+    }
+private:
+    const Value& m_value;
 };
 
 }
@@ -226,12 +442,12 @@ private:
  * @brief Parsing given null-terminated character array and store all parsed
  * JSON objects {} or arrays [] on the stack
  *
- * Because this use stack to store all parsed JSON objects, only last
- * parsed data will be pop from stack and stored to given value output.
- * operator>>() behave like input stream and may be used in the chain:
+ * Parsed JSON value is stored directly to given value output, no copy of
+ * it is kept. operator>>() behave like input stream and may be used in
+ * the chain, next values get copy of the same parsed value:
  *
  * @code
- * R"({"key1":1, "key2":2}[1, 2])" >> value2 >> value1;
+ * R"({"key1":1, "key2":2})" >> value2 >> value1;
  * @endcode
  *
  * @param[in]   str     String contains JSON objects {} or arrays [].
@@ -240,23 +456,18 @@ private:
  *
  * @param[out]  value   JSON value to store from the stack
  * */
-static inline
-json::Deserializer operator>>(const char* str, json::Value& value) {
-    json::Deserializer deserializer(str);
-    value = deserializer.get_value();
-    return deserializer;
-}
+json::Extraction operator>>(const char* str, json::Value& value);
 
 /*!
  * @brief Parsing given String object and store all parsed JSON objects {}
  * or arrays [] on the stack
  *
- * Because this use stack to store all parsed JSON objects, only last
- * parsed data will be pop from stack and stored to given value output.
- * operator>>() behave like input stream and may be used in the chain:
+ * Parsed JSON value is stored directly to given value output, no copy of
+ * it is kept. operator>>() behave like input stream and may be used in
+ * the chain, next values get copy of the same parsed value:
  *
  * @code
- * R"({"key1":1, "key2":2}[1, 2])" >> value2 >> value1;
+ * R"({"key1":1, "key2":2})" >> value2 >> value1;
  * @endcode
  *
  * @param[in]   str     String contains JSON objects {} or arrays [].
@@ -265,23 +476,18 @@ json::Deserializer operator>>(const char* str, json::Value& value) {
  *
  * @param[out]  value   JSON value to store from the stack
  * */
-static inline
-json::Deserializer operator>>(const std::string& str, json::Value& value) {
-    json::Deserializer deserializer(str);
-    value = deserializer.get_value();
-    return deserializer;
-}
+json::Extraction operator>>(const std::string& str, json::Value& value);
 
 /*!
  * @brief Parsing given null-terminated character array and store all parsed
  * JSON objects {} or arrays [] on the stack
  *
- * Because this use stack to store all parsed JSON objects, only last
- * parsed data will be pop from stack and stored to given value output.
- * operator>>() behave like input stream and may be used in the chain:
+ * Parsed JSON value is stored directly to given value output, no copy of
+ * it is kept. operator>>() behave like input stream and may be used in
+ * the chain, next values get copy of the same parsed value:
  *
  * @code
- * R"({"key1":1, "key2":2}[1, 2])" >> value2 >> value1;
+ * R"({"key1":1, "key2":2})" >> value2 >> value1;
  * @endcode
  *
  * @param[in]   str     String contains JSON objects {} or arrays [].
@@ -291,7 +497,7 @@ json::Deserializer operator>>(const std::string& str, json::Value& value) {
  * @param[out]  value   JSON value to store from the stack
  * */
 template<std::size_t N>
-json::Deserializer operator>>(const char str[N], json::Value& value) {
+json::Extraction operator>>(const char str[N], json::Value& value) {
     return str >> value;
 }
 
@@ -70,7 +70,12 @@ public:
         INVALID_UNICODE,
         INVALID_NUMBER_INTEGER,
         INVALID_NUMBER_FRACTION,
-        INVALID_NUMBER_EXPONENT
+        INVALID_NUMBER_EXPONENT,
+        INVALID_STRING_CHARACTER,
+        INVALID_UTF8,
+        STRING_LIMIT_REACHED,
+        TAPE_LIMIT_REACHED,
+        OUT_OF_MEMORY
     };
 
     DeserializerError(Code code, std::size_t offset);
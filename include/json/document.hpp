@@ -0,0 +1,411 @@
+/*!
+ * @copyright
+ * Copyright (c) 2015, Tymoteusz Blazejczyk
+ *
+ * @copyright
+ * All rights reserved.
+ *
+ * @copyright
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * @copyright
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * @copyright
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * @copyright
+ * * Neither the name of json-cxx nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * @copyright
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file json/document.hpp
+ *
+ * @brief JSON document interface
+ * */
+
+#ifndef JSON_CXX_DOCUMENT_HPP
+#define JSON_CXX_DOCUMENT_HPP
+
+#include <json/value.hpp>
+#include <json/arena.hpp>
+
+#include <string>
+#include <limits>
+#include <cstring>
+#include <cstdint>
+
+namespace json {
+
+class KeyTable;
+
+/*!
+ * @brief Read-only JSON node of JSON document
+ *
+ * Node is a lightweight view of parsed JSON value. Nodes, their elements
+ * and strings are stored in document arena and they are valid until
+ * document is cleared, parsed again or destroyed
+ * */
+class Node {
+public:
+    friend class Parser;
+
+    /*! JSON type, the same as for JSON value */
+    using Type = Value::Type;
+
+    /*!
+     * @brief Create JSON null node
+     * */
+    Node() : m_type(Type::NIL), m_boolean(false) { }
+
+    /*!
+     * @brief Get JSON type
+     * */
+    Type get_type() const { return m_type; }
+
+    bool is_string() const { return Type::STRING == m_type; }
+
+    bool is_object() const { return Type::OBJECT == m_type; }
+
+    bool is_array() const { return Type::ARRAY == m_type; }
+
+    bool is_number() const { return Type::NUMBER == m_type; }
+
+    bool is_boolean() const { return Type::BOOLEAN == m_type; }
+
+    bool is_null() const { return Type::NIL == m_type; }
+
+    /*!
+     * @brief Get number of elements in JSON array or object
+     *
+     * For any others JSON types it returns always zero
+     *
+     * @return  Number of JSON array or object elements
+     * */
+    std::size_t size() const;
+
+    /*!
+     * @brief Check if JSON array or object is empty
+     *
+     * @return   true when container is empty otherwise false
+     * */
+    bool empty() const { return !size(); }
+
+    /*!
+     * @brief Access to JSON array element or JSON object member value
+     *
+     * When node is not neither array or object, return myself
+     *
+     * @param[in]   index   Element index
+     *
+     * @return  JSON node indexed in array or object, otherwise return myself
+     * */
+    const Node& operator[](std::size_t index) const;
+
+    /*!
+     * @brief Access to JSON array element or JSON object member value
+     *
+     * When node is not neither array or object, return myself
+     *
+     * @param[in]   index   Element index
+     *
+     * @return  JSON node indexed in array or object, otherwise return myself
+     * */
+    const Node& operator[](int index) const {
+        return (*this)[std::size_t(index)];
+    }
+
+    /*!
+     * @brief Access to JSON object member value
+     *
+     * When member with given key doesn't exist, it returns global JSON null
+     * node. For other JSON types return myself
+     *
+     * @param[in]   key     JSON object member key
+     *
+     * @return  JSON node from JSON object
+     * */
+    const Node& operator[](const char* key) const;
+
+    /*!
+     * @brief Access to JSON object member value
+     *
+     * When member with given key doesn't exist, it returns global JSON null
+     * node. For other JSON types return myself
+     *
+     * @param[in]   key     JSON object member key
+     *
+     * @return  JSON node from JSON object
+     * */
+    const Node& operator[](const String& key) const {
+        return (*this)[key.c_str()];
+    }
+
+    /*!
+     * @brief Get key of JSON object member
+     *
+     * Key is not null-terminated when document was parsed as view,
+     * use key_length()
+     *
+     * @param[in]   index   Member index
+     *
+     * @return  Null-terminated key
+     * */
+    const char* key(std::size_t index) const;
+
+    /*!
+     * @brief Get key length of JSON object member
+     *
+     * @param[in]   index   Member index
+     *
+     * @return  Key length in bytes without null termination
+     * */
+    std::size_t key_length(std::size_t index) const;
+
+    bool is_member(const char* key) const;
+
+    bool is_member(const String& key) const {
+        return is_member(key.c_str());
+    }
+
+    /*!
+     * @brief Get JSON string length
+     *
+     * @return  String length in bytes without null termination
+     * */
+    std::size_t length() const;
+
+    /*!
+     * @brief Get JSON string characters
+     *
+     * String is not null-terminated when document was parsed as view,
+     * use length()
+     *
+     * @return  Null-terminated string
+     * */
+    const char* as_char() const;
+
+    String as_string() const;
+
+    Bool as_bool() const;
+
+    Null as_null() const;
+
+    Int as_int() const;
+
+    Uint as_uint() const;
+
+    Int64 as_int64() const;
+
+    Uint64 as_uint64() const;
+
+    Double as_double() const;
+
+    const Number& as_number() const;
+
+    /*!
+     * @brief Create JSON value with copy of node and all its elements
+     *
+     * Members with duplicated keys are kept in order, the same as when
+     * JSON text is parsed to JSON value
+     *
+     * @return  JSON value
+     * */
+    Value to_value() const;
+private:
+    struct Member;
+
+    /*! Sequence of elements stored in arena */
+    template<typename T>
+    struct Range {
+        const T* data;
+        std::size_t size;
+    };
+
+    const Member* find(const char* key) const;
+
+    Type m_type;
+    union {
+        Bool m_boolean;
+        Number m_number;
+        Range<char> m_string;
+        Range<Node> m_array;
+        Range<Member> m_object;
+    };
+};
+
+/*! JSON object member of JSON document */
+struct Node::Member {
+    Member() : key{nullptr, 0}, value() { }
+
+    Range<char> key;
+    Node value;
+};
+
+/*!
+ * @brief Read-only JSON document
+ *
+ * Whole parsed document, nodes and strings, is stored in single monotonic
+ * arena. There is no heap allocation per node and document is released at
+ * once in clear(), without visiting nodes. When document is parsed again,
+ * arena memory is reused
+ *
+ * @code
+ * json::Document document;
+ * document.parsing(R"({"key":[1,2,3]})");
+ * document.get_root()["key"][1].as_int();
+ * @endcode
+ * */
+class Document {
+public:
+    static constexpr const std::size_t DEFAULT_LIMIT_PER_OBJECT =
+        std::numeric_limits<std::uint32_t>::max();
+
+    /*!
+     * @brief Create empty document
+     *
+     * @param[in]   chunk_size  Size of first arena heap chunk
+     * */
+    Document(std::size_t chunk_size = Arena::DEFAULT_CHUNK_SIZE);
+
+    /*!
+     * @brief Create empty document that uses caller-supplied buffer first
+     *
+     * When document fits in buffer, no heap memory is used for nodes.
+     * Buffer must outlive document
+     *
+     * @param[in]   buffer  Memory buffer
+     * @param[in]   size    Buffer size in bytes
+     * */
+    Document(void* buffer, std::size_t size);
+
+    /*!
+     * @brief Parse JSON text
+     *
+     * Previous document content is released first. When parsing fails,
+     * DeserializerError is thrown and document root is JSON null
+     *
+     * @param[in]   str     JSON text
+     * @param[in]   length  JSON text length
+     * */
+    void parsing(const char* str, std::size_t length);
+
+    void parsing(const char* str) {
+        parsing(str, std::strlen(str));
+    }
+
+    void parsing(const std::string& str) {
+        parsing(str.data(), str.size());
+    }
+
+    /*!
+     * @brief Parse JSON file
+     *
+     * File is memory-mapped and parsed in place, strings are copied to
+     * arena so mapping is released after parsing. Throws std::system_error
+     * when file cannot be read
+     *
+     * @param[in]   path    Path to JSON file
+     * */
+    void parsing_file(const char* path);
+
+    void parsing_file(const std::string& path) {
+        parsing_file(path.c_str());
+    }
+
+    /*!
+     * @brief Parse JSON text without copying strings
+     *
+     * Strings and keys without escapes reference given JSON text, only
+     * strings with escapes are decoded to arena. JSON text must be kept
+     * unchanged as long as document is used. Referenced strings are not
+     * null-terminated
+     *
+     * @param[in]   str     JSON text
+     * @param[in]   length  JSON text length
+     * */
+    void parsing_view(const char* str, std::size_t length);
+
+    void parsing_view(const std::string& str) {
+        parsing_view(str.data(), str.size());
+    }
+
+    /*!
+     * @brief Set maximum characters to parse per JSON object or array
+     *
+     * @param[in]   limit   Maximum characters to parse per JSON object
+     *                      or array
+     * */
+    void set_limit(std::size_t limit) {
+        m_limit = limit;
+    }
+
+    /*!
+     * @brief Enable two-stage parsing with structural index
+     *
+     * @param[in]   enable  Use structural index
+     * */
+    void set_structural_index(bool enable) {
+        m_structural_index = enable;
+    }
+
+    /*!
+     * @brief Intern object keys in shared key table
+     *
+     * Keys are not copied to document arena, they reference interned keys
+     * shared by all documents parsed with the same table. Table must
+     * outlive document. When table is full, keys are copied as usual
+     *
+     * @param[in]   keys    Key table, nullptr to disable interning
+     * */
+    void set_key_table(KeyTable* keys) {
+        m_keys = keys;
+    }
+
+    const Node& get_root() const {
+        return m_root;
+    }
+
+    /*!
+     * @brief Release all nodes at once
+     * */
+    void clear();
+
+    const Arena& get_arena() const {
+        return m_arena;
+    }
+
+    ~Document();
+private:
+    Document(const Document&) = delete;
+    Document(Document&&) = delete;
+    Document& operator=(const Document&) = delete;
+    Document& operator=(Document&&) = delete;
+
+    Arena m_arena;
+    Node m_root;
+    std::size_t m_limit;
+    bool m_structural_index;
+    KeyTable* m_keys;
+};
+
+}
+
+#endif /* JSON_CXX_DOCUMENT_HPP */
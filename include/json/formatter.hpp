@@ -47,7 +47,10 @@
 #include <json/writter.hpp>
 #include <json/value.hpp>
 
+#include <array>
+#include <string>
 #include <cstdint>
+#include <cstring>
 
 namespace json {
 
@@ -56,9 +59,22 @@ namespace json {
  * */
 class Formatter {
 public:
+    /*! Size of internal buffer used to collect formatted output */
+    static constexpr std::size_t BUFFER_SIZE{4096};
+
     Formatter(Writter* writter = nullptr);
 
+    /*!
+     * @brief Set writter used for formatted output
+     *
+     * Output left in buffer is discarded, it belongs to previous writter
+     * that may be already destroyed. Formatting always ends with flush,
+     * so pending output exists only when previous writter failed
+     *
+     * @param[in]   writter Writter
+     * */
     void set_writter(Writter* writter) {
+        m_length = 0;
         m_writter = writter;
     }
 
@@ -76,8 +92,76 @@ public:
     /*! Destructor */
     virtual ~Formatter();
 protected:
-    Writter* m_writter;
+    /*!
+     * @brief Pass buffered output to writter
+     *
+     * Must be called when formatting is finished
+     * */
+    void flush();
+
+    /*!
+     * @brief Get writter for direct writes
+     *
+     * Buffered output is passed to writter first, so direct writes are
+     * kept in order with buffered writes
+     *
+     * @return  Writter or nullptr when not set
+     * */
+    Writter* get_direct_writter() {
+        flush();
+        return m_writter;
+    }
+
+    /*!
+     * @brief Buffered write of single character
+     *
+     * @param[in]   ch  Character
+     * */
+    void write(char ch) {
+        if (BUFFER_SIZE == m_length) { flush(); }
+        m_buffer[m_length++] = ch;
+    }
+
+    /*!
+     * @brief Buffered write of repeated character
+     *
+     * @param[in]   count   Number of characters
+     * @param[in]   ch      Character
+     * */
+    void write(std::size_t count, char ch);
+
+    /*!
+     * @brief Buffered write of characters
+     *
+     * @param[in]   str     Characters
+     * @param[in]   length  Number of characters
+     * */
+    void write(const char* str, std::size_t length) {
+        if (length <= (BUFFER_SIZE - m_length)) {
+            std::memcpy(m_buffer.data() + m_length, str, length);
+            m_length += length;
+        }
+        else {
+            write_large(str, length);
+        }
+    }
+
+    /*!
+     * @brief Buffered write of string
+     *
+     * @param[in]   str     String
+     * */
+    void write(const std::string& str) {
+        write(str.data(), str.size());
+    }
+
 private:
+    void write_large(const char* str, std::size_t length);
+
+    Writter* m_writter;
+    std::array<char, BUFFER_SIZE> m_buffer;
+    std::size_t m_length;
+
     Formatter(const Formatter&) = delete;
     Formatter(Formatter&&) = delete;
     Formatter& operator=(const Formatter&) = delete;
@@ -65,6 +65,20 @@ public:
      * */
     virtual void formatting(const Value& value) override;
 
+    /*!
+     * @brief Enable or disable escaping of non-ASCII characters
+     *
+     * When enabled, UTF-8 characters above 0x7F are written as \\uXXXX
+     * escape sequences, characters outside of Basic Multilingual Plane as
+     * surrogate pairs. Invalid UTF-8 sequences are replaced with U+FFFD.
+     * Disabled by default
+     *
+     * @param[in]   enable  Escape non-ASCII characters
+     * */
+    void set_escape_unicode(bool enable) { m_escape_unicode = enable; }
+
+    bool is_escape_unicode() const { return m_escape_unicode; }
+
     /*! Destructor */
     virtual ~Compact();
 protected:
@@ -75,6 +89,21 @@ protected:
     virtual void write_number(const Number& number);
     virtual void write_boolean(Bool value);
     virtual void write_empty();
+private:
+    /*!
+     * @brief Write escaped string character
+     *
+     * @param[in]   pos     Character that needs escaping
+     * @param[in]   end     End of string
+     *
+     * @return  Pointer to the next unwritten character
+     * */
+    const char* write_escape(const char* pos, const char* end);
+
+    /*! Write code unit as \\uXXXX escape sequence */
+    void write_unicode(unsigned code);
+
+    bool m_escape_unicode{false};
 };
 
 }
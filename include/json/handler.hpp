@@ -0,0 +1,103 @@
+/*!
+ * @copyright
+ * Copyright (c) 2015, Tymoteusz Blazejczyk
+ *
+ * @copyright
+ * All rights reserved.
+ *
+ * @copyright
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * @copyright
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * @copyright
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * @copyright
+ * * Neither the name of json-cxx nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * @copyright
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file handler.hpp
+ *
+ * @brief JSON parser events handler interface
+ * */
+
+#ifndef JSON_CXX_HANDLER_HPP
+#define JSON_CXX_HANDLER_HPP
+
+#include <json/value.hpp>
+
+#include <cstddef>
+
+namespace json {
+
+/*!
+ * @brief Base class for receiving parser events (SAX-style)
+ *
+ * Parser calls handler methods in document order without building any
+ * JSON value. Objects generate begin_object(), pairs of key() and value
+ * event and end_object(). Arrays generate begin_array(), value events and
+ * end_array(). Default implementations do nothing, so derived class only
+ * overrides events it is interested in.
+ *
+ * Strings passed to string() and key() are valid only during the call.
+ * They are not null-terminated and escape sequences are already decoded
+ * */
+class Handler {
+public:
+    /*! Default constructor */
+    Handler();
+
+    /*! JSON null value */
+    virtual void null();
+
+    /*! JSON true or false value */
+    virtual void boolean(Bool boolean);
+
+    /*! JSON number value */
+    virtual void number(const Number& number);
+
+    /*! JSON string value */
+    virtual void string(const char* str, std::size_t length);
+
+    /*! JSON object member name, followed by member value event */
+    virtual void key(const char* str, std::size_t length);
+
+    /*! Opening curly bracket { */
+    virtual void begin_object();
+
+    /*! Closing curly bracket } */
+    virtual void end_object();
+
+    /*! Opening square bracket [ */
+    virtual void begin_array();
+
+    /*! Closing square bracket ] */
+    virtual void end_array();
+
+    /*! Destructor */
+    virtual ~Handler();
+};
+
+}
+
+#endif /* JSON_CXX_HANDLER_HPP */
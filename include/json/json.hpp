@@ -50,8 +50,20 @@
 #include <json/formatter.hpp>
 #include <json/serializer.hpp>
 #include <json/deserializer.hpp>
+#include <json/handler.hpp>
+#include <json/stream_deserializer.hpp>
+#include <json/lines_deserializer.hpp>
+#include <json/document.hpp>
+#include <json/cursor.hpp>
+#include <json/tape.hpp>
+#include <json/key_table.hpp>
+#include <json/arena.hpp>
 
 #include <json/writter/string.hpp>
+#include <json/writter/counter.hpp>
+#include <json/writter/file.hpp>
+#include <json/writter/fd.hpp>
+#include <json/writter/ostream.hpp>
 
 #include <json/formatter/compact.hpp>
 #include <json/formatter/pretty.hpp>
@@ -0,0 +1,163 @@
+/*!
+ * @copyright
+ * Copyright (c) 2015, Tymoteusz Blazejczyk
+ *
+ * @copyright
+ * All rights reserved.
+ *
+ * @copyright
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * @copyright
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * @copyright
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * @copyright
+ * * Neither the name of json-cxx nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * @copyright
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file json/key_table.hpp
+ *
+ * @brief JSON key table interface
+ * */
+
+#ifndef JSON_CXX_KEY_TABLE_HPP
+#define JSON_CXX_KEY_TABLE_HPP
+
+#include <json/value.hpp>
+
+#include <atomic>
+#include <memory>
+#include <cstring>
+#include <cstdint>
+
+namespace json {
+
+/*!
+ * @brief Thread-safe table of interned JSON object keys
+ *
+ * Each distinct key is stored once, as immutable null-terminated string
+ * that is valid as long as table exists. Documents parsed with the same
+ * table share their keys, so the same key has always the same address and
+ * keys can be compared by pointers. Table is split into shards locked
+ * separately, it can be shared by documents parsed in many threads
+ *
+ * @code
+ * json::KeyTable keys;
+ * json::Document document;
+ * document.set_key_table(&keys);
+ * document.parsing(R"({"key":1})");
+ * document.get_root().key(0) == keys.intern("key");
+ * @endcode
+ * */
+class KeyTable {
+public:
+    /*! Default maximum number of interned keys */
+    static constexpr std::size_t DEFAULT_MAX_KEYS{65536};
+
+    /*!
+     * @brief Create empty table
+     *
+     * @param[in]   max_keys    Maximum number of interned keys, it bounds
+     *                          memory used for keys from untrusted input
+     * */
+    KeyTable(std::size_t max_keys = DEFAULT_MAX_KEYS);
+
+    /*!
+     * @brief Get interned key, add it when it is not in table yet
+     *
+     * @param[in]   str     Key characters
+     * @param[in]   length  Key length
+     *
+     * @return  Interned null-terminated key or nullptr when table is full
+     * */
+    const char* intern(const char* str, std::size_t length) {
+        return intern(str, length, hash(str, length));
+    }
+
+    const char* intern(const char* str) {
+        return intern(str, std::strlen(str));
+    }
+
+    const char* intern(const String& str) {
+        return intern(str.data(), str.size());
+    }
+
+    /*!
+     * @brief Get interned key with already computed hash
+     *
+     * @param[in]   str     Key characters
+     * @param[in]   length  Key length
+     * @param[in]   hash    Key hash from hash()
+     *
+     * @return  Interned null-terminated key or nullptr when table is full
+     * */
+    const char* intern(const char* str, std::size_t length,
+            std::uint64_t hash);
+
+    /*!
+     * @brief Get number of interned keys
+     * */
+    std::size_t size() const;
+
+    /*!
+     * @brief Compute key hash, FNV-1a
+     *
+     * @param[in]   str     Key characters
+     * @param[in]   length  Key length
+     *
+     * @return  Key hash
+     * */
+    static std::uint64_t hash(const char* str, std::size_t length) {
+        std::uint64_t value = 14695981039346656037u;
+
+        for (std::size_t i = 0; i < length; ++i) {
+            value = (value ^ static_cast<unsigned char>(str[i]))
+                * 1099511628211u;
+        }
+
+        return value;
+    }
+
+    ~KeyTable();
+private:
+    KeyTable(const KeyTable&) = delete;
+    KeyTable(KeyTable&&) = delete;
+    KeyTable& operator=(const KeyTable&) = delete;
+    KeyTable& operator=(KeyTable&&) = delete;
+
+    /*! Number of separately locked parts of table */
+    static constexpr std::size_t SHARDS{16};
+
+    struct Shard;
+
+    std::unique_ptr<Shard[]> m_shards;
+    /*! Maximum number of keys in all shards */
+    std::size_t m_max_keys;
+    /*! Number of keys in all shards */
+    std::atomic<std::size_t> m_size;
+};
+
+}
+
+#endif /* JSON_CXX_KEY_TABLE_HPP */
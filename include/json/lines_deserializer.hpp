@@ -0,0 +1,199 @@
+/*!
+ * @copyright
+ * Copyright (c) 2015, Tymoteusz Blazejczyk
+ *
+ * @copyright
+ * All rights reserved.
+ *
+ * @copyright
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * @copyright
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * @copyright
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * @copyright
+ * * Neither the name of json-cxx nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * @copyright
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file lines_deserializer.hpp
+ *
+ * @brief JSON lines deserializer interface
+ * */
+
+#ifndef JSON_CXX_LINES_DESERIALIZER_HPP
+#define JSON_CXX_LINES_DESERIALIZER_HPP
+
+#include <json/value.hpp>
+#include <json/deserializer.hpp>
+
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <functional>
+
+namespace json {
+
+/*!
+ * @brief JSON deserialization of newline-delimited JSON (NDJSON, JSON Lines)
+ *
+ * Input is split on newlines and records are parsed in parallel by worker
+ * threads. Empty lines are skipped. Records are numbered from zero in the
+ * input order, without empty lines.
+ *
+ * Records are returned in the input order, or passed to callback as soon as
+ * they are parsed. Callback is invoked concurrently from worker threads in
+ * any order, so it must be thread-safe.
+ *
+ * When any record fails, DeserializerError with offset from the input
+ * beginning is thrown after all workers stop. Workers are started once per
+ * parsing call. Files are read in blocks while workers parse the previous
+ * block, so with callback whole file is never kept in memory
+ * */
+class LinesDeserializer {
+public:
+    /*! Parsed record callback: record index and parsed JSON value */
+    using Callback = std::function<void(std::size_t, Value&)>;
+
+    static constexpr const std::size_t DEFAULT_BLOCK_SIZE = 1 << 20;
+
+    /*! Use one worker per hardware thread */
+    LinesDeserializer();
+
+    /*!
+     * @brief Use given number of workers
+     *
+     * @param[in]   threads     Number of worker threads, zero for one
+     *                          worker per hardware thread
+     * */
+    LinesDeserializer(std::size_t threads);
+
+    ~LinesDeserializer();
+
+    /*!
+     * @brief Set maximum characters to parse per JSON object or array
+     * */
+    void set_limit(std::size_t limit) {
+        m_limit = limit;
+    }
+
+    /*!
+     * @brief Set size of blocks read from file
+     *
+     * Block is extended when single record doesn't fit in it
+     *
+     * @param[in]   block_size  Characters read at once, zero for default
+     *                          block size
+     * */
+    void set_block_size(std::size_t block_size) {
+        m_block_size = (0 != block_size) ? block_size : DEFAULT_BLOCK_SIZE;
+    }
+
+    /*!
+     * @brief Parse records and append them to values in the input order
+     *
+     * @param[in]   str     Newline-delimited JSON text
+     * @param[in]   length  Number of characters to parse
+     * @param[out]  values  Parsed JSON values
+     * */
+    void parsing(const char* str, std::size_t length,
+            std::vector<Value>& values);
+
+    void parsing(const std::string& str, std::vector<Value>& values) {
+        parsing(str.data(), str.size(), values);
+    }
+
+    /*!
+     * @brief Parse records and pass them to callback in any order
+     *
+     * @param[in]   str         Newline-delimited JSON text
+     * @param[in]   length      Number of characters to parse
+     * @param[in]   callback    Called from worker threads for each record
+     * */
+    void parsing(const char* str, std::size_t length,
+            const Callback& callback);
+
+    void parsing(const std::string& str, const Callback& callback) {
+        parsing(str.data(), str.size(), callback);
+    }
+
+    /*!
+     * @brief Read file to the end, append records to values in the input
+     * order
+     *
+     * Throws std::system_error on read failure
+     *
+     * @param[in]   file    File opened for reading
+     * @param[out]  values  Parsed JSON values
+     * */
+    void parsing(std::FILE* file, std::vector<Value>& values);
+
+    /*!
+     * @brief Read file to the end, pass records to callback in any order
+     *
+     * Throws std::system_error on read failure
+     *
+     * @param[in]   file        File opened for reading
+     * @param[in]   callback    Called from worker threads for each record
+     * */
+    void parsing(std::FILE* file, const Callback& callback);
+private:
+    /*! Single line of JSON text */
+    struct Record {
+        const char* str;
+        std::size_t length;
+        /*! Characters from the input beginning */
+        std::size_t offset;
+    };
+
+    /*! Records of input text parsed together by workers */
+    struct Block;
+
+    /*! Fill next block with records, false when there is no more input */
+    using Source = std::function<bool(Block&)>;
+
+    /*! Parse record at given position of the block */
+    using Task = std::function<void(Block&, std::size_t)>;
+
+    /*! Take parsed block, called in the input order */
+    using Collect = std::function<void(Block&)>;
+
+    LinesDeserializer(const LinesDeserializer&) = delete;
+    LinesDeserializer(LinesDeserializer&&) = delete;
+    LinesDeserializer& operator=(const LinesDeserializer&) = delete;
+    LinesDeserializer& operator=(LinesDeserializer&&) = delete;
+
+    void split(Block& block, const char* str, std::size_t length,
+            std::size_t offset) const;
+    void run(const Source& source, const Task& task, const Collect& collect);
+    bool reading(std::FILE* file, Block& block, std::string& rest,
+            std::size_t& offset) const;
+
+    std::size_t m_threads;
+    std::size_t m_limit{Deserializer::DEFAULT_LIMIT_PER_OBJECT};
+    std::size_t m_block_size{DEFAULT_BLOCK_SIZE};
+};
+
+}
+
+#endif /* JSON_CXX_LINES_DESERIALIZER_HPP */
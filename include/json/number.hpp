@@ -70,6 +70,7 @@ using Double = double;
 class Number {
 public:
     friend class Parser;
+    friend class TapeView;
 
     /*! JSON number type */
     enum Type {
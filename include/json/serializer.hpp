@@ -48,6 +48,7 @@
 #include <json/formatter.hpp>
 
 #include <string>
+#include <ostream>
 
 namespace json {
 
@@ -76,6 +77,46 @@ public:
 
     void write(const Value& value);
 
+    /*!
+     * @brief Serialize JSON C++ value directly to writter
+     *
+     * Serialized data is not stored in serializer. Writter is flushed when
+     * serialization is done. Exact size mode is not used
+     *
+     * @param[in]   value   JSON C++ to serialize
+     * @param[out]  writter Output writter
+     * */
+    void write(const Value& value, Writter& writter);
+
+    /*!
+     * @brief Serialize JSON C++ value directly to output stream
+     *
+     * Only formatter buffer is used, data is written straight to stream.
+     * Output stream is not flushed, it is left to the caller
+     *
+     * @param[in]   value   JSON C++ to serialize
+     * @param[out]  os      Output stream
+     * */
+    void write(const Value& value, std::ostream& os);
+
+    /*!
+     * @brief Enable or disable exact size mode
+     *
+     * In exact size mode, output size is measured by formatting value to
+     * writter::Counter first. Then output is allocated once and formatted
+     * again. This trades second formatting pass for single allocation
+     * without unused capacity. Disabled by default
+     *
+     * @param[in]   enable  Enable exact size mode
+     * */
+    void set_exact_size(bool enable) {
+        m_exact_size = enable;
+    }
+
+    bool is_exact_size() const {
+        return m_exact_size;
+    }
+
     const std::string& read() const {
         return m_serialized;
     }
@@ -106,6 +147,7 @@ private:
 
     Formatter* m_formatter;
     std::string m_serialized;
+    bool m_exact_size;
 };
 
 }
@@ -119,8 +161,8 @@ private:
  * */
 static inline
 std::ostream& operator<<(std::ostream& os, const json::Value& value) {
-    json::Serializer serializer(value);
-    return os << serializer.read();
+    json::Serializer().write(value, os);
+    return os;
 }
 
 /*!
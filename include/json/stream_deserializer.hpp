@@ -0,0 +1,174 @@
+/*!
+ * @copyright
+ * Copyright (c) 2015, Tymoteusz Blazejczyk
+ *
+ * @copyright
+ * All rights reserved.
+ *
+ * @copyright
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * @copyright
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * @copyright
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * @copyright
+ * * Neither the name of json-cxx nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * @copyright
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file stream_deserializer.hpp
+ *
+ * @brief JSON incremental deserializer interface
+ * */
+
+#ifndef JSON_CXX_STREAM_DESERIALIZER_HPP
+#define JSON_CXX_STREAM_DESERIALIZER_HPP
+
+#include <json/value.hpp>
+#include <json/deserializer.hpp>
+
+#include <string>
+#include <memory>
+#include <cstring>
+
+namespace json {
+
+class Parser;
+class Handler;
+
+/*!
+ * @brief Incremental JSON deserialization from chunks of JSON text
+ *
+ * Chunks may be split at any character, for example as they are received
+ * from network socket. Parsing state is kept between calls and only
+ * incomplete token is buffered, so parsing overlaps with receiving:
+ *
+ * @code
+ * json::StreamDeserializer deserializer;
+ *
+ * while (!deserializer.is_complete() && (size = recv(fd, data, 4096, 0))) {
+ *     deserializer.parsing(data, std::size_t(size));
+ * }
+ * deserializer.finish();
+ * @endcode
+ *
+ * Without handler, parsed JSON value is available after document completes.
+ * With handler, parsing events are passed to it and no JSON value is created.
+ * When parsing fails, deserializer must be cleared before next document
+ * */
+class StreamDeserializer {
+public:
+    /*! Parse to JSON value */
+    StreamDeserializer();
+
+    /*!
+     * @brief Pass parsing events to given handler
+     *
+     * @param[in]   handler Parsing events handler
+     * */
+    StreamDeserializer(Handler& handler);
+
+    ~StreamDeserializer();
+
+    /*!
+     * @brief Parse next chunk of JSON text
+     *
+     * @param[in]   str     Next chunk of JSON text
+     * @param[in]   length  Chunk length
+     *
+     * @return  true when JSON document is complete
+     * */
+    bool parsing(const char* str, std::size_t length);
+
+    bool parsing(const std::string& str) {
+        return parsing(str.data(), str.size());
+    }
+
+    bool parsing(const char* str) {
+        return parsing(str, std::strlen(str));
+    }
+
+    StreamDeserializer& operator<<(const std::string& str) {
+        parsing(str.data(), str.size());
+        return *this;
+    }
+
+    StreamDeserializer& operator<<(const char* str) {
+        parsing(str, std::strlen(str));
+        return *this;
+    }
+
+    /*!
+     * @brief Mark end of JSON text
+     *
+     * Completes JSON document that ends with number. Throws
+     * DeserializerError when JSON document is incomplete
+     * */
+    void finish();
+
+    bool is_complete() const { return m_complete; }
+
+    /*!
+     * @brief Set maximum characters to parse per JSON object or array
+     *
+     * New limit is used from the next JSON document
+     * */
+    void set_limit(std::size_t limit) {
+        m_limit = limit;
+    }
+
+    const Value& get_value() const {
+        return m_value;
+    }
+
+    /*!
+     * @brief Move parsed JSON value out of the deserializer
+     *
+     * @return  Parsed JSON value
+     * */
+    Value release() {
+        Value value(std::move(m_value));
+        m_value = nullptr;
+        return value;
+    }
+
+    /*! Drop parsing state and parsed JSON value, start next document */
+    void clear();
+private:
+    StreamDeserializer(const StreamDeserializer&) = delete;
+    StreamDeserializer(StreamDeserializer&&) = delete;
+    StreamDeserializer& operator=(const StreamDeserializer&) = delete;
+    StreamDeserializer& operator=(StreamDeserializer&&) = delete;
+
+    bool parsing(const char* str, std::size_t length, bool last);
+
+    Handler* m_handler{nullptr};
+    std::unique_ptr<Parser> m_parser{};
+    Value m_value = nullptr;
+    std::size_t m_limit{Deserializer::DEFAULT_LIMIT_PER_OBJECT};
+    bool m_complete{false};
+};
+
+}
+
+#endif /* JSON_CXX_STREAM_DESERIALIZER_HPP */
@@ -0,0 +1,389 @@
+/*!
+ * @copyright
+ * Copyright (c) 2015, Tymoteusz Blazejczyk
+ *
+ * @copyright
+ * All rights reserved.
+ *
+ * @copyright
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * @copyright
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * @copyright
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * @copyright
+ * * Neither the name of json-cxx nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * @copyright
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file tape.hpp
+ *
+ * @brief JSON tape interface
+ * */
+
+#ifndef JSON_CXX_TAPE_HPP
+#define JSON_CXX_TAPE_HPP
+
+#include <json/value.hpp>
+
+#include <limits>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <cstring>
+#include <cstdint>
+
+namespace json {
+
+class Tape;
+
+/*!
+ * @brief Read-only view of JSON value stored in tape
+ *
+ * View is valid until tape is cleared, parsed again or destroyed
+ * */
+class TapeView {
+public:
+    /*! JSON type, the same as for JSON value */
+    using Type = Value::Type;
+
+    class Iterator;
+
+    /*! Create view of JSON null value */
+    TapeView() : m_tape{nullptr}, m_index{0} { }
+
+    TapeView(const TapeView&) = default;
+    TapeView& operator=(const TapeView&) = default;
+
+    Type get_type() const;
+
+    bool is_string() const { return Type::STRING == get_type(); }
+
+    bool is_object() const { return Type::OBJECT == get_type(); }
+
+    bool is_array() const { return Type::ARRAY == get_type(); }
+
+    bool is_number() const { return Type::NUMBER == get_type(); }
+
+    bool is_boolean() const { return Type::BOOLEAN == get_type(); }
+
+    bool is_null() const { return Type::NIL == get_type(); }
+
+    /*!
+     * @brief Get number of elements in JSON array or object
+     *
+     * For any others JSON types it returns always zero
+     * */
+    std::size_t size() const;
+
+    bool empty() const { return !size(); }
+
+    /*!
+     * @brief Access to JSON array element or JSON object member value
+     *
+     * Preceding elements are skipped with containers skip indexes. When
+     * index is out of range or view is neither array nor object, JSON null
+     * view is returned
+     *
+     * @param[in]   index   Element index
+     * */
+    TapeView operator[](std::size_t index) const;
+
+    TapeView operator[](int index) const {
+        return (*this)[std::size_t(index)];
+    }
+
+    /*!
+     * @brief Access to JSON object member value
+     *
+     * When member doesn't exist or view is not an object, JSON null view
+     * is returned
+     *
+     * @param[in]   key     JSON object member key
+     * */
+    TapeView operator[](const char* key) const {
+        return find(key, std::strlen(key));
+    }
+
+    TapeView operator[](const String& key) const {
+        return find(key.data(), key.size());
+    }
+
+    bool is_member(const char* key) const {
+        return find(key, std::strlen(key)).is_valid();
+    }
+
+    bool is_member(const String& key) const {
+        return find(key.data(), key.size()).is_valid();
+    }
+
+    /*!
+     * @brief Check if view points to value stored in tape
+     *
+     * @return  false for missing object member or array element
+     * */
+    bool is_valid() const { return nullptr != m_tape; }
+
+    Iterator begin() const;
+
+    Iterator end() const;
+
+    /*!
+     * @brief Get JSON string length
+     *
+     * @return  String length in bytes without null termination
+     * */
+    std::size_t length() const;
+
+    /*!
+     * @brief Get JSON string characters
+     *
+     * @return  Null-terminated string
+     * */
+    const char* as_char() const;
+
+    String as_string() const;
+
+    Bool as_bool() const;
+
+    Int as_int() const { return Int(as_number()); }
+
+    Uint as_uint() const { return Uint(as_number()); }
+
+    Int64 as_int64() const { return Int64(as_number()); }
+
+    Uint64 as_uint64() const { return Uint64(as_number()); }
+
+    Double as_double() const { return Double(as_number()); }
+
+    Number as_number() const;
+
+    /*!
+     * @brief Create JSON value with copy of view and all its elements
+     *
+     * Duplicated keys are kept in order, the same as parsing to value
+     *
+     * @return  JSON value
+     * */
+    Value to_value() const;
+private:
+    friend class Tape;
+
+    TapeView(const Tape* tape, std::size_t index) :
+        m_tape{tape}, m_index{index} { }
+
+    TapeView find(const char* key, std::size_t length) const;
+
+    /*! Index of the word after given value */
+    std::size_t next(std::size_t index) const;
+
+    std::uint64_t word() const;
+
+    const Tape* m_tape;
+    std::size_t m_index;
+};
+
+/*!
+ * @brief Forward iterator over JSON array elements or JSON object members
+ * */
+class TapeView::Iterator {
+public:
+    Iterator(const Iterator&) = default;
+    Iterator& operator=(const Iterator&) = default;
+
+    /*! JSON array element or JSON object member value */
+    TapeView operator*() const;
+
+    /*!
+     * @brief Get key of JSON object member
+     *
+     * @return  Null-terminated key, empty string for JSON array element
+     * */
+    const char* key() const;
+
+    Iterator& operator++() {
+        m_index = m_view.next(m_index + (m_object ? 1 : 0));
+        return *this;
+    }
+
+    bool operator==(const Iterator& other) const {
+        return m_index == other.m_index;
+    }
+
+    bool operator!=(const Iterator& other) const {
+        return m_index != other.m_index;
+    }
+private:
+    friend class TapeView;
+
+    Iterator(const TapeView& view, std::size_t index, bool object) :
+        m_view{view}, m_index{index}, m_object{object} { }
+
+    TapeView m_view;
+    /*! Current element, member key for JSON object */
+    std::size_t m_index;
+    bool m_object;
+};
+
+/*!
+ * @brief Read-optimized JSON document stored as flat tape
+ *
+ * Whole document is kept in contiguous array of 64-bit words, one word per
+ * JSON value, two words per number. Containers begin with word that holds
+ * index of the word after container end, so they are skipped without
+ * visiting their elements. All strings are kept in single buffer
+ *
+ * @code
+ * json::Tape tape;
+ * tape.parsing(R"({"key":[1,2,3]})");
+ * for (const auto& element : tape.get_root()["key"]) { element.as_int(); }
+ * @endcode
+ * */
+class Tape {
+public:
+    static constexpr const std::size_t DEFAULT_LIMIT_PER_OBJECT =
+        std::numeric_limits<std::uint32_t>::max();
+
+    /*! Create empty tape with JSON null value */
+    Tape();
+
+    /*!
+     * @brief Parse JSON text
+     *
+     * Previous tape content is released first. When parsing fails,
+     * DeserializerError is thrown and tape holds JSON null value
+     *
+     * @param[in]   str     JSON text
+     * @param[in]   length  JSON text length
+     * */
+    void parsing(const char* str, std::size_t length);
+
+    void parsing(const char* str) {
+        parsing(str, std::strlen(str));
+    }
+
+    void parsing(const std::string& str) {
+        parsing(str.data(), str.size());
+    }
+
+    void set_limit(std::size_t limit) {
+        m_limit = limit;
+    }
+
+    /*!
+     * @brief Set maximum number of tape words
+     *
+     * Container begin word stores index of the word after container end
+     * on 32 bits, so limit can't be greater than default one. When
+     * container ends after the limit, DeserializerError with
+     * TAPE_LIMIT_REACHED code is thrown
+     *
+     * @param[in]   limit   Maximum number of tape words
+     * */
+    void set_words_limit(std::size_t limit) {
+        m_words_limit = std::min<std::size_t>(limit, INDEX_MASK);
+    }
+
+    /*!
+     * @brief Enable two-stage parsing with structural index
+     *
+     * @param[in]   enable  Use structural index
+     * */
+    void set_structural_index(bool enable) {
+        m_structural_index = enable;
+    }
+
+    TapeView get_root() const;
+
+    /*! Set JSON null value, keep allocated memory for reuse */
+    void clear();
+
+    /*! Number of 64-bit words used by values */
+    std::size_t get_words_size() const { return m_words.size(); }
+
+    /*! Number of bytes used by strings */
+    std::size_t get_strings_size() const { return m_strings.size(); }
+
+    ~Tape();
+private:
+    friend class Parser;
+    friend class TapeView;
+
+    /*! Word type stored in the highest byte */
+    enum Tag : std::uint8_t {
+        TAG_NULL = 'n',
+        TAG_TRUE = 't',
+        TAG_FALSE = 'f',
+        TAG_INT = 'l',
+        TAG_UINT = 'u',
+        TAG_DOUBLE = 'd',
+        TAG_STRING = '"',
+        TAG_ARRAY = '[',
+        TAG_ARRAY_END = ']',
+        TAG_OBJECT = '{',
+        TAG_OBJECT_END = '}'
+    };
+
+    static constexpr unsigned TAG_SHIFT = 56;
+    static constexpr unsigned COUNT_SHIFT = 32;
+    static constexpr std::uint64_t INDEX_MASK = 0xFFFFFFFF;
+    /*! Containers elements count saturates at that value */
+    static constexpr std::uint64_t COUNT_MAX = 0xFFFFFF;
+
+    static_assert(INDEX_MASK < (std::uint64_t(1) << COUNT_SHIFT),
+            "Index overlaps elements count");
+    static_assert(COUNT_MAX < (std::uint64_t(1) << (TAG_SHIFT - COUNT_SHIFT)),
+            "Elements count overlaps tag");
+
+    static Tag get_tag(std::uint64_t word) {
+        return Tag(word >> TAG_SHIFT);
+    }
+
+    static std::uint64_t make_word(Tag tag, std::uint64_t payload = 0) {
+        return (std::uint64_t(tag) << TAG_SHIFT) | payload;
+    }
+
+    Tape(const Tape&) = delete;
+    Tape(Tape&&) = delete;
+    Tape& operator=(const Tape&) = delete;
+    Tape& operator=(Tape&&) = delete;
+
+    /*!
+     * Tape words, type in the highest byte:
+     * - string: offset of string in strings buffer
+     * - numbers: value bits in the next word
+     * - container begin: index of the word after container end in lower
+     *   32 bits and number of elements in bits 32-55
+     * - container end: index of container begin word
+     * */
+    std::vector<std::uint64_t> m_words;
+    /*! Strings, each is 32-bit length, characters and null termination */
+    String m_strings;
+    std::size_t m_limit;
+    std::size_t m_words_limit;
+    bool m_structural_index;
+};
+
+}
+
+#endif /* JSON_CXX_TAPE_HPP */
@@ -49,7 +49,9 @@
 #include <string>
 #include <vector>
 #include <utility>
+#include <new>
 #include <cstdint>
+#include <type_traits>
 
 namespace json {
 
@@ -80,6 +82,12 @@ using Null = std::nullptr_t;
  * @brief JSON value
  *
  * JSON value class that can contain JSON object, array, number, boolen or null
+ *
+ * Value takes 16 bytes. Numbers, booleans and nulls are stored inline and
+ * strings, arrays and objects are stored out of line, so arrays of scalars
+ * keep four values per 64 bytes cache line. Strings are not stored in
+ * the value itself, because String accessors return std::string
+ * references. Short strings are kept in place by std::string instead
  * */
 class Value {
 public:
@@ -256,16 +264,18 @@ public:
      * @brief Move constructor
      *
      * After moving JSON value to new object, given JSON value is changed to
-     * JSON null
+     * JSON null. Out of line storage is only taken over
      * */
-    Value(Value&& value);
+    Value(Value&& value) noexcept { take(value); }
 
     /*!
      * @brief Destructor
      *
      * Call suitable JSON type destructor based on his Type
      * */
-    ~Value();
+    ~Value() {
+        if (has_storage()) { destroy(); }
+    }
 
     /*!
      * @brief Copy assignment
@@ -282,11 +292,20 @@ public:
      *
      * If JSON values type are not equal, destroy old contents, create new JSON
      * type based on given JSON value argument and move all data. JSON value
-     * that data have been moved to object, will be changed to JSON null
+     * that data have been moved to object, will be changed to JSON null.
+     * Given JSON value may be part of this JSON value, so it is taken
+     * before old contents are destroyed
      *
      * @param[in]   value   JSON value to move
      * */
-    Value& operator=(Value&& value);
+    Value& operator=(Value&& value) noexcept {
+        if (this != &value) {
+            Value moved(std::move(value));
+            if (has_storage()) { destroy(); }
+            take(moved);
+        }
+        return *this;
+    }
 
     /*!
      * @brief Assignment JSON object with JSON members
@@ -402,6 +421,26 @@ public:
      * */
     void push_back(const Value& value);
 
+    /*!
+     * @brief Push at the end new JSON value using move semantic
+     *
+     * @param[in]   value    JSON value
+     * */
+    void push_back(Value&& value);
+
+    /*!
+     * @brief Append new JSON member using move semantic
+     *
+     * This work only for JSON object type. When JSON is a null, JSON type
+     * will be changed to JSON object. Unlike push_back(), member with the
+     * same key is not replaced, duplicated keys are kept like in parsed
+     * JSON text
+     *
+     * @param[in]   key     JSON member key
+     * @param[in]   value   JSON member value
+     * */
+    void append(String&& key, Value&& value);
+
     /*!
      * @brief Pop JSON value or member from JSON array or object
      *
@@ -668,14 +707,17 @@ public:
     /*!
      * @brief Get JSON type
      * */
-    Type get_type() const { return m_type; }
+    Type get_type() const {
+        return (m_storage.tag <= TAG_DOUBLE) ? Type::NUMBER :
+            Type(m_storage.tag - TAG_NIL);
+    }
 
     /*!
      * @brief Check if JSON value is a string
      * @return true when is otherwise false
      * */
     bool is_string() const {
-        return Type::STRING == m_type;
+        return TAG_STRING == m_storage.tag;
     }
 
     /*!
@@ -683,7 +725,7 @@ public:
      * @return true when is otherwise false
      * */
     bool is_object() const {
-        return Type::OBJECT == m_type;
+        return TAG_OBJECT == m_storage.tag;
     }
 
     /*!
@@ -691,7 +733,7 @@ public:
      * @return true when is otherwise false
      * */
     bool is_array() const {
-        return Type::ARRAY == m_type;
+        return TAG_ARRAY == m_storage.tag;
     }
 
     /*!
@@ -699,7 +741,7 @@ public:
      * @return true when is otherwise false
      * */
     bool is_number() const {
-        return Type::NUMBER == m_type;
+        return m_storage.tag <= TAG_DOUBLE;
     }
 
     /*!
@@ -707,7 +749,7 @@ public:
      * @return true when is otherwise false
      * */
     bool is_boolean() const {
-        return Type::BOOLEAN == m_type;
+        return TAG_BOOLEAN == m_storage.tag;
     }
 
     /*!
@@ -715,7 +757,7 @@ public:
      * @return true when is otherwise false
      * */
     bool is_null() const {
-        return Type::NIL == m_type;
+        return TAG_NIL == m_storage.tag;
     }
 
     /*!
@@ -723,7 +765,7 @@ public:
      * @return true when is otherwise false
      * */
     bool is_int() const {
-        return is_number() ? Number(m_number).is_int() : false;
+        return TAG_INT == m_storage.tag;
     }
 
     /*!
@@ -731,7 +773,7 @@ public:
      * @return true when is otherwise false
      * */
     bool is_uint() const {
-        return is_number() ? Number(m_number).is_uint() : false;
+        return TAG_UINT == m_storage.tag;
     }
 
     /*!
@@ -739,7 +781,7 @@ public:
      * @return true when is otherwise false
      * */
     bool is_double() const {
-        return is_number() ? Number(m_number).is_double() : false;
+        return TAG_DOUBLE == m_storage.tag;
     }
 
     /*!
@@ -763,16 +805,18 @@ public:
     }
 
     /*! Convert JSON value to string */
-    explicit operator String&() { return m_string; }
+    explicit operator String&() { return *m_storage.string; }
 
     /*! Convert JSON value to string */
-    explicit operator const String&() const { return m_string; }
+    explicit operator const String&() const { return *m_storage.string; }
 
     /*! Convert JSON value to string */
-    explicit operator const char*() const { return m_string.c_str(); }
+    explicit operator const char*() const {
+        return m_storage.string->c_str();
+    }
 
     /*! Convert JSON value to boolean */
-    explicit operator Bool() const { return m_boolean; }
+    explicit operator Bool() const { return m_storage.boolean; }
 
     /*! Convert JSON value to null */
     explicit operator Null() const { return nullptr; }
@@ -793,16 +837,18 @@ public:
     explicit operator Double() const { return Double(m_number); }
 
     /*! Convert JSON value to array */
-    explicit operator Array&() { return m_array; }
+    explicit operator Array&() { return *m_storage.array; }
 
     /*! Convert JSON value to number */
     explicit operator Number&() { return m_number; }
 
     /*! Convert JSON value to array */
-    explicit operator const Array&() const { return m_array; }
+    explicit operator const Array&() const { return *m_storage.array; }
 
     /*! Convert JSON value to object */
-    explicit operator const Object&() const { return m_object; }
+    explicit operator const Object&() const {
+        return *m_storage.object;
+    }
 
     /*! Convert JSON value to number */
     explicit operator const Number&() const { return m_number; }
@@ -893,14 +939,163 @@ public:
     /*! End const iterator */
     const_iterator cend() const;
 private:
-    enum Type m_type;
+    /*!
+     * @brief JSON object storage with hashed members index
+     *
+     * When JSON object has at least INDEX_THRESHOLD members, hash index of
+     * member keys is built and used by find() instead of linear search.
+     * Index is updated when member is appended or erased. After any other
+     * change of members order or count, reindex() must be called. Members
+     * order is not affected by index. For duplicated keys, first member is
+     * found
+     * */
+    class Members : public Object {
+    public:
+        /*! Minimal number of members that are indexed */
+        static constexpr std::size_t INDEX_THRESHOLD{16};
+
+        Members();
+
+        Members(std::initializer_list<Pair> init_list);
+
+        Members(const Members& other);
+
+        Members(Members&& other) noexcept;
+
+        Members& operator=(const Members& other);
+
+        Members& operator=(Members&& other) noexcept;
+
+        /*!
+         * @brief Find first member with given key
+         *
+         * @param[in]   key     Null-terminated characters array
+         *
+         * @return  Pointer to member or nullptr when not found
+         * */
+        Pair* find(const char* key);
+
+        /*!
+         * @brief Find first member with given key
+         *
+         * @param[in]   key     Null-terminated characters array
+         *
+         * @return  Pointer to member or nullptr when not found
+         * */
+        const Pair* find(const char* key) const;
+
+        /*!
+         * @brief Append new member with given key and JSON null value
+         *
+         * @param[in]   key     Member key
+         *
+         * @return  Appended JSON value
+         * */
+        Value& append(String key);
+
+        /*!
+         * @brief Erase member and update index
+         *
+         * @param[in]   pos     Member to erase
+         *
+         * @return  Iterator following erased member
+         * */
+        Object::iterator erase(Object::const_iterator pos);
+
+        /*!
+         * @brief Erase members and update index
+         *
+         * Index is dropped when members count goes below INDEX_THRESHOLD
+         *
+         * @param[in]   first   First member to erase
+         * @param[in]   last    Member following last member to erase
+         *
+         * @return  Iterator following erased members
+         * */
+        Object::iterator erase(Object::const_iterator first,
+                Object::const_iterator last);
+
+        /*!
+         * @brief Erase last member and update index
+         * */
+        void pop_back();
+
+        /*!
+         * @brief Rebuild or drop index after members have been changed
+         * */
+        void reindex();
+
+        ~Members();
+    private:
+        class Index;
+
+        Index* m_index;
+    };
+
+    /*!
+     * @brief Packed JSON type tag
+     *
+     * Tag is stored in place of JSON number type and number types are also
+     * tags, so JSON number is stored inline with no separate JSON type.
+     * TAG_NUMBER is never stored, it keeps tags in the same order as Type
+     * */
+    enum Tag : std::underlying_type<Number::Type>::type {
+        TAG_INT = Number::Type::INT,
+        TAG_UINT = Number::Type::UINT,
+        TAG_DOUBLE = Number::Type::DOUBLE,
+        TAG_NIL,
+        TAG_OBJECT,
+        TAG_ARRAY,
+        TAG_STRING,
+        TAG_NUMBER,
+        TAG_BOOLEAN
+    };
+
+    /*! Non-number JSON value, tag has the same place as Number type */
+    struct Storage {
+        Tag tag;
+        union {
+            Bool boolean;
+            String* string;
+            Array* array;
+            Members* object;
+        };
+    };
+
+    /*! Check if string, array or object is stored out of line */
+    bool has_storage() const {
+        return (TAG_OBJECT <= m_storage.tag) && (m_storage.tag <= TAG_STRING);
+    }
+
+    /*! Release out of line storage, JSON type is not changed */
+    void destroy();
+
+    /*!
+     * Take contents of given JSON value without releasing own one. Given
+     * JSON value is changed to JSON null
+     * */
+    void take(Value& value) noexcept {
+        if (value.is_number()) {
+            new (&m_number) Number(value.m_number);
+        }
+        else {
+            m_storage = value.m_storage;
+        }
+        value.m_storage.tag = TAG_NIL;
+    }
+
+    /*! Collect members of given JSON object that are not in this object */
+    void collect_members(const Value& value, Members& members) const;
+
+    /*! Collect members of given JSON object that are not in this object */
+    void collect_members(Value&& value, Members& members) const;
+
+    /*! Insert collected members before given position */
+    iterator insert_members(const_iterator pos, Members& members);
 
     union {
-        Object m_object;
-        Array m_array;
-        String m_string;
         Number m_number;
-        Bool m_boolean;
+        Storage m_storage;
     };
 };
 
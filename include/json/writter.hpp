@@ -68,6 +68,13 @@ public:
 
     virtual void write(const std::string& str) = 0;
 
+    /*!
+     * @brief Pass written data to final output
+     *
+     * Called when serialization is done. Default does nothing
+     * */
+    virtual void flush();
+
     /*! Destructor */
     virtual ~Writter();
 };
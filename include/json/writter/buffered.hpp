@@ -0,0 +1,108 @@
+/*!
+ * @copyright
+ * Copyright (c) 2015, Tymoteusz Blazejczyk
+ *
+ * @copyright
+ * All rights reserved.
+ *
+ * @copyright
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * @copyright
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * @copyright
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * @copyright
+ * * Neither the name of json-cxx nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * @copyright
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file writter/buffered.hpp
+ *
+ * @brief JSON writter interface
+ * */
+
+#ifndef JSON_CXX_WRITTER_BUFFERED_HPP
+#define JSON_CXX_WRITTER_BUFFERED_HPP
+
+#include <json/writter.hpp>
+
+#include <vector>
+#include <cstdint>
+
+namespace json {
+namespace writter {
+
+/*!
+ * @brief Buffered writter
+ *
+ * Base class for writters that stream serialized JSON data to an output.
+ * Data is collected in a fixed size buffer and passed to output only
+ * when buffer is full or on flush(), so memory usage doesn't depend on
+ * serialized data size. Derived classes must call flush() in their
+ * destructors
+ * */
+class Buffered : public Writter {
+public:
+    /*! Default buffer size */
+    static constexpr std::size_t DEFAULT_BUFFER_SIZE{65536};
+
+    Buffered(std::size_t buffer_size = DEFAULT_BUFFER_SIZE);
+
+    /*!
+     * @brief Discard buffered data that wasn't passed to output yet
+     * */
+    virtual void clear() override;
+
+    virtual void write(char ch) override;
+
+    virtual void write(std::size_t size, char ch) override;
+
+    virtual void write(const char* str) override;
+
+    virtual void write(const char* str, std::size_t length) override;
+
+    virtual void write(const std::string& str) override;
+
+    /*!
+     * @brief Pass all buffered data to output
+     * */
+    virtual void flush() override;
+
+    virtual ~Buffered();
+protected:
+    /*!
+     * @brief Write data to output
+     *
+     * @param[in]   data    Data to write
+     * @param[in]   length  Data length in bytes
+     * */
+    virtual void output(const char* data, std::size_t length) = 0;
+private:
+    std::vector<char> m_buffer;
+    std::size_t m_length;
+};
+
+}
+}
+
+#endif /* JSON_CXX_WRITTER_BUFFERED_HPP */
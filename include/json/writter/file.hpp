@@ -0,0 +1,85 @@
+/*!
+ * @copyright
+ * Copyright (c) 2015, Tymoteusz Blazejczyk
+ *
+ * @copyright
+ * All rights reserved.
+ *
+ * @copyright
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * @copyright
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * @copyright
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * @copyright
+ * * Neither the name of json-cxx nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * @copyright
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file writter/file.hpp
+ *
+ * @brief JSON writter interface
+ * */
+
+#ifndef JSON_CXX_WRITTER_FILE_HPP
+#define JSON_CXX_WRITTER_FILE_HPP
+
+#include <json/writter/buffered.hpp>
+
+#include <cstdio>
+
+namespace json {
+namespace writter {
+
+/*!
+ * @brief File writter
+ *
+ * Streams serialized JSON data to C standard library file. File is not
+ * closed by writter. Throws std::system_error on write failure
+ * */
+class File : public Buffered {
+public:
+    File(std::FILE* file, std::size_t buffer_size = DEFAULT_BUFFER_SIZE);
+
+    /*!
+     * @brief Pass all buffered data and flush file stream
+     * */
+    virtual void flush() override;
+
+    /*! Destructor, remaining buffered data is flushed */
+    virtual ~File();
+protected:
+    virtual void output(const char* data, std::size_t length) override;
+private:
+    File(const File&) = delete;
+    File(File&&) = delete;
+    File& operator=(const File&) = delete;
+    File& operator=(File&&) = delete;
+
+    std::FILE* m_file;
+};
+
+}
+}
+
+#endif /* JSON_CXX_WRITTER_FILE_HPP */
@@ -0,0 +1,148 @@
+/*!
+ * @copyright
+ * Copyright (c) 2015, Tymoteusz Blazejczyk
+ *
+ * @copyright
+ * All rights reserved.
+ *
+ * @copyright
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * @copyright
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * @copyright
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * @copyright
+ * * Neither the name of json-cxx nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * @copyright
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file arena.cpp
+ *
+ * @brief JSON arena implementation
+ * */
+
+#include "json/arena.hpp"
+
+#include <new>
+#include <algorithm>
+
+using json::Arena;
+
+/*! Heap chunk header, chunk memory follows it */
+struct Arena::Chunk {
+    Chunk* next;
+    std::size_t size;
+};
+
+Arena::Arena(std::size_t chunk_size) :
+    m_current{nullptr},
+    m_end{nullptr},
+    m_buffer{nullptr},
+    m_buffer_size{0},
+    m_chunks{nullptr},
+    m_spare{nullptr},
+    m_chunk_size{std::max<std::size_t>(chunk_size, sizeof(Chunk))},
+    m_heap_size{0}
+{ }
+
+Arena::Arena(void* buffer, std::size_t size, std::size_t chunk_size) :
+    m_current{static_cast<char*>(buffer)},
+    m_end{static_cast<char*>(buffer) + size},
+    m_buffer{static_cast<char*>(buffer)},
+    m_buffer_size{size},
+    m_chunks{nullptr},
+    m_spare{nullptr},
+    m_chunk_size{std::max<std::size_t>(chunk_size, sizeof(Chunk))},
+    m_heap_size{0}
+{ }
+
+Arena::~Arena() {
+    free_chunks();
+}
+
+void* Arena::allocate_chunk(std::size_t size, std::size_t alignment) {
+    const std::size_t required = sizeof(Chunk) + size + alignment;
+    Chunk* chunk;
+
+    if ((nullptr != m_spare) && (required <= m_spare->size)) {
+        chunk = m_spare;
+    }
+    else {
+        /* Chunks grow geometrically, so there are only few of them */
+        std::size_t chunk_size = std::max(m_chunk_size, required);
+
+        chunk = static_cast<Chunk*>(::operator new(chunk_size));
+        chunk->next = m_chunks;
+        chunk->size = chunk_size;
+
+        m_chunks = chunk;
+        m_heap_size += chunk_size;
+        m_chunk_size = 2 * chunk_size;
+    }
+
+    m_spare = nullptr;
+    m_current = reinterpret_cast<char*>(chunk) + sizeof(Chunk);
+    m_end = reinterpret_cast<char*>(chunk) + chunk->size;
+
+    return allocate(size, alignment);
+}
+
+void Arena::clear() {
+    /* Replace many chunks with single one that fits all of them */
+    if ((nullptr != m_chunks) && (nullptr != m_chunks->next)) {
+        const std::size_t heap_size = m_heap_size;
+
+        free_chunks();
+
+        m_chunks = static_cast<Chunk*>(::operator new(heap_size));
+        m_chunks->next = nullptr;
+        m_chunks->size = heap_size;
+        m_heap_size = heap_size;
+    }
+
+    m_spare = nullptr;
+
+    if (nullptr != m_buffer) {
+        /* Heap chunk is used again when buffer is full */
+        m_spare = m_chunks;
+        m_current = m_buffer;
+        m_end = m_buffer + m_buffer_size;
+    }
+    else if (nullptr != m_chunks) {
+        m_current = reinterpret_cast<char*>(m_chunks) + sizeof(Chunk);
+        m_end = reinterpret_cast<char*>(m_chunks) + m_chunks->size;
+    }
+    else {
+        m_current = nullptr;
+        m_end = nullptr;
+    }
+}
+
+void Arena::free_chunks() {
+    while (nullptr != m_chunks) {
+        Chunk* next = m_chunks->next;
+        ::operator delete(m_chunks);
+        m_chunks = next;
+    }
+    m_heap_size = 0;
+}
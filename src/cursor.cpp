@@ -0,0 +1,386 @@
+/*!
+ * @copyright
+ * Copyright (c) 2015, Tymoteusz Blazejczyk
+ *
+ * @copyright
+ * All rights reserved.
+ *
+ * @copyright
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * @copyright
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * @copyright
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * @copyright
+ * * Neither the name of json-cxx nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * @copyright
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file cursor.cpp
+ *
+ * @brief JSON on-demand cursor implementation
+ * */
+
+#include "json/cursor.hpp"
+#include "json/deserializer.hpp"
+#include "json/value_error.hpp"
+
+#include "parser.hpp"
+#include "simd.hpp"
+
+using json::Value;
+using json::Cursor;
+using json::Parser;
+using json::ValueError;
+using Error = json::DeserializerError;
+
+Cursor::Cursor() :
+    m_begin{nullptr},
+    m_current{nullptr},
+    m_end{nullptr}
+{ }
+
+Cursor::Cursor(const char* str, std::size_t length) :
+    m_begin{str},
+    m_current{nullptr},
+    m_end{str + length}
+{
+    const char* pos = skip_whitespaces(str);
+
+    if (pos < m_end) { m_current = pos; }
+}
+
+Cursor::Cursor(const char* begin, const char* current, const char* end) :
+    m_begin{begin},
+    m_current{current},
+    m_end{end}
+{ }
+
+Cursor::Type Cursor::get_type() const {
+    if (nullptr == m_current) { return Type::NIL; }
+
+    Type type;
+
+    switch (*m_current) {
+    case '"':
+        type = Type::STRING;
+        break;
+    case '{':
+        type = Type::OBJECT;
+        break;
+    case '[':
+        type = Type::ARRAY;
+        break;
+    case 't':
+    case 'f':
+        type = Type::BOOLEAN;
+        break;
+    default:
+        type = ('n' == *m_current) ? Type::NIL : Type::NUMBER;
+        break;
+    }
+
+    return type;
+}
+
+std::size_t Cursor::size() const {
+    const bool object = is_object();
+
+    if (!object && !is_array()) { return 0; }
+
+    const char close = object ? '}' : ']';
+    const char* pos = read_first(close);
+    const char* key;
+    std::size_t length;
+    std::size_t count = 0;
+
+    while (nullptr != pos) {
+        if (object) { pos = read_key(pos, &key, length); }
+        pos = read_separator(skip_value(pos), close);
+        ++count;
+    }
+
+    return count;
+}
+
+Cursor Cursor::operator[](std::size_t index) const {
+    const bool object = is_object();
+
+    if (!object && !is_array()) { return Cursor(); }
+
+    const char close = object ? '}' : ']';
+    const char* pos = read_first(close);
+    const char* key;
+    std::size_t length;
+
+    while (nullptr != pos) {
+        if (object) { pos = read_key(pos, &key, length); }
+        if (0 == index--) { return Cursor(m_begin, pos, m_end); }
+        pos = read_separator(skip_value(pos), close);
+    }
+
+    return Cursor();
+}
+
+/*!
+ * Keys are compared as they are in JSON text. Only keys with escapes
+ * are decoded before comparison
+ * */
+Cursor Cursor::find(const char* str, std::size_t size) const {
+    if (!is_object()) { return Cursor(); }
+
+    const char* pos = read_first('}');
+    const char* key;
+    std::size_t length;
+
+    while (nullptr != pos) {
+        pos = read_key(pos, &key, length);
+
+        if (nullptr == std::memchr(key, '\\', length)) {
+            if ((length == size) && (0 == std::memcmp(key, str, size))) {
+                return Cursor(m_begin, pos, m_end);
+            }
+        }
+        else if (Cursor(m_begin, key - 1, m_end).as_string()
+                == String(str, size)) {
+            return Cursor(m_begin, pos, m_end);
+        }
+
+        pos = read_separator(skip_value(pos), '}');
+    }
+
+    return Cursor();
+}
+
+json::String Cursor::as_string() const {
+    if (!is_string()) {
+        throw ValueError(ValueError::NOT_STRING);
+    }
+
+    const char* end = skip_string(m_current + 1) - 1;
+
+    if ((simd::find_string_special(m_current + 1, end) == end)) {
+        return String(m_current + 1, end);
+    }
+
+    return std::move(to_value().as_string());
+}
+
+json::Bool Cursor::as_bool() const {
+    if (!is_boolean()) {
+        throw ValueError(ValueError::NOT_BOOLEAN);
+    }
+    return to_value().as_bool();
+}
+
+json::Number Cursor::as_number() const {
+    if (!is_number()) {
+        throw ValueError(ValueError::NOT_NUMBER);
+    }
+    return to_value().as_number();
+}
+
+Value Cursor::to_value() const {
+    Value value;
+
+    if (nullptr == m_current) { return value; }
+
+    const char* end = skip_value(m_current);
+
+    try {
+        Parser(m_current, std::size_t(end - m_current),
+                Deserializer::DEFAULT_LIMIT_PER_OBJECT).parsing(value);
+    }
+    catch (const Error& error) {
+        throw Error(error.get_code(),
+                std::size_t(m_current - m_begin) + error.get_offset());
+    }
+
+    return value;
+}
+
+const char* Cursor::skip_value(const char* pos) const {
+    switch (*pos) {
+    case '"':
+        return skip_string(pos + 1);
+    case '{':
+    case '[':
+        return skip_container(pos);
+    default:
+        break;
+    }
+
+    const char* value = pos;
+
+    while ((pos < m_end) && (',' != *pos) && ('}' != *pos)
+            && (']' != *pos) && (' ' != *pos) && ('\n' != *pos)
+            && ('\r' != *pos) && ('\t' != *pos)) {
+        ++pos;
+    }
+
+    if (pos == value) {
+        throw_error(Error::MISS_VALUE, pos);
+    }
+
+    return pos;
+}
+
+/*!
+ * @return  Position after closing quote
+ * */
+const char* Cursor::skip_string(const char* pos) const {
+    while (true) {
+        pos = simd::find_string_special(pos, m_end);
+
+        if (pos >= m_end) {
+            throw_error(Error::END_OF_FILE, pos);
+        }
+
+        if ('"' == *pos) { break; }
+
+        if ('\\' != *pos) {
+            throw_error(Error::INVALID_STRING_CHARACTER, pos);
+        }
+
+        if (++pos >= m_end) {
+            throw_error(Error::END_OF_FILE, pos);
+        }
+        ++pos;
+    }
+
+    return pos + 1;
+}
+
+/*!
+ * Only brackets nesting is counted, their kinds and elements between them
+ * are not validated
+ *
+ * @return  Position after closing bracket
+ * */
+const char* Cursor::skip_container(const char* pos) const {
+    std::size_t depth = 0;
+
+    do {
+        pos = simd::find_structural(pos, m_end);
+
+        if (pos >= m_end) {
+            throw_error(Error::END_OF_FILE, pos);
+        }
+
+        switch (*pos) {
+        case '"':
+            pos = skip_string(pos + 1);
+            break;
+        case '{':
+        case '[':
+            ++depth;
+            ++pos;
+            break;
+        case '}':
+        case ']':
+            --depth;
+            ++pos;
+            break;
+        default:
+            ++pos;
+            break;
+        }
+    } while (0 != depth);
+
+    return pos;
+}
+
+const char* Cursor::skip_whitespaces(const char* pos) const {
+    return simd::skip_whitespaces(pos, m_end);
+}
+
+/*!
+ * @return  First element position, nullptr for empty container
+ * */
+const char* Cursor::read_first(char close) const {
+    const char* pos = skip_whitespaces(m_current + 1);
+
+    if (pos >= m_end) {
+        throw_error(Error::END_OF_FILE, pos);
+    }
+
+    return (close == *pos) ? nullptr : pos;
+}
+
+/*!
+ * @return  Member value position
+ * */
+const char* Cursor::read_key(const char* pos, const char** key,
+        std::size_t& length) const {
+    if ('"' != *pos) {
+        throw_error(Error::MISS_QUOTE, pos);
+    }
+
+    *key = pos + 1;
+    pos = skip_string(pos + 1);
+    length = std::size_t(pos - 1 - *key);
+
+    pos = skip_whitespaces(pos);
+    if ((pos >= m_end) || (':' != *pos)) {
+        throw_error((pos >= m_end) ? Error::END_OF_FILE : Error::MISS_COLON,
+                pos);
+    }
+
+    pos = skip_whitespaces(pos + 1);
+    if (pos >= m_end) {
+        throw_error(Error::END_OF_FILE, pos);
+    }
+
+    return pos;
+}
+
+/*!
+ * @return  Next element position, nullptr after last element
+ * */
+const char* Cursor::read_separator(const char* pos, char close) const {
+    pos = skip_whitespaces(pos);
+
+    if (pos >= m_end) {
+        throw_error(Error::END_OF_FILE, pos);
+    }
+
+    if (',' == *pos) {
+        pos = skip_whitespaces(pos + 1);
+        if (pos >= m_end) {
+            throw_error(Error::END_OF_FILE, pos);
+        }
+        return pos;
+    }
+
+    if (close != *pos) {
+        throw_error(('}' == close) ? Error::MISS_CURLY_CLOSE :
+                Error::MISS_SQUARE_CLOSE, pos);
+    }
+
+    return nullptr;
+}
+
+[[noreturn]] void Cursor::throw_error(Error::Code code,
+        const char* pos) const {
+    throw Error(code, std::size_t(pos - m_begin));
+}
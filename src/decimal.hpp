@@ -0,0 +1,111 @@
+/*!
+ * @copyright
+ * Copyright (c) 2015, Tymoteusz Blazejczyk
+ *
+ * @copyright
+ * All rights reserved.
+ *
+ * @copyright
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * @copyright
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * @copyright
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * @copyright
+ * * Neither the name of json-cxx nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * @copyright
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file decimal.hpp
+ *
+ * @brief JSON decimal to binary floating-point conversion interface
+ * */
+
+#ifndef JSON_CXX_DECIMAL_HPP
+#define JSON_CXX_DECIMAL_HPP
+
+#include <json/number.hpp>
+
+#include <cstdint>
+#include <cstddef>
+
+namespace json {
+
+/*!
+ * @brief Decimal number split into parts by the parser
+ *
+ * Number value is equal to mantissa * 10^exponent. When significand has
+ * more digits than fits in the mantissa, mantissa holds only leading digits
+ * and all digits are still available in integer and fraction parts
+ * */
+struct Decimal {
+    /*! Leading significant digits */
+    Uint64 mantissa;
+    /*! Power of ten applied to mantissa */
+    Int64 exponent;
+    /*! Integer part digits */
+    const char* integer;
+    /*! Number of integer part digits */
+    std::size_t integer_length;
+    /*! Fractional part digits */
+    const char* fraction;
+    /*! Number of fractional part digits */
+    std::size_t fraction_length;
+    /*! Exponent part value */
+    Int64 explicit_exponent;
+    /*! Negative number */
+    bool negative;
+    /*! Mantissa doesn't contain all significant digits */
+    bool truncated;
+};
+
+/*!
+ * @brief Convert decimal number to the nearest double (round half to even)
+ *
+ * Exact powers of ten and Eisel-Lemire algorithm are used on the fast path.
+ * Only when truncated mantissa is ambiguous, all digits are compared with
+ * halfway point using big integers arithmetic
+ *
+ * @param[in]   decimal     Decimal number
+ *
+ * @return  Correctly rounded double
+ * */
+Double decimal_to_double(const Decimal& decimal);
+
+/*!
+ * @brief Convert exact decimal number mantissa * 10^exponent to double
+ *
+ * Used when parser has all significant digits in mantissa and doesn't
+ * need to fill whole Decimal structure
+ *
+ * @param[in]   mantissa    All significant digits
+ * @param[in]   exponent    Power of ten applied to mantissa
+ * @param[in]   negative    Negative number
+ *
+ * @return  Correctly rounded double
+ * */
+Double decimal_to_double(Uint64 mantissa, Int64 exponent, bool negative);
+
+}
+
+#endif /* JSON_CXX_DECIMAL_HPP */
@@ -43,8 +43,14 @@
 
 #include "json/deserializer.hpp"
 #include "parser.hpp"
+#include "mapped_file.hpp"
+
+#include "json/handler.hpp"
+
+#include <new>
 
 using json::Parser;
+using json::MappedFile;
 using json::Deserializer;
 
 /*! Maximu characters to parse per single JSON value. Stack protection */
@@ -59,6 +65,71 @@ void Deserializer::clear() {
 }
 
 void Deserializer::parsing(const char* str, std::size_t length) {
+    parsing(str, length, m_value);
+}
+
+void Deserializer::parsing(const char* str, std::size_t length, Value& value) {
+    Parser parser(str, length, m_limit);
+    parser.set_indexed(m_structural_index);
+    parser.parsing(value);
+}
+
+Deserializer::Result Deserializer::try_parsing(const char* str,
+        std::size_t length, Value& value) noexcept {
     Parser parser(str, length, m_limit);
-    parser.parsing(m_value);
+    parser.set_indexed(m_structural_index);
+
+    try {
+        parser.try_parsing(value);
+    }
+    catch (const std::bad_alloc&) {
+        value = nullptr;
+        return {DeserializerError::OUT_OF_MEMORY, 0};
+    }
+    return {parser.get_error(), parser.get_error_offset()};
+}
+
+Deserializer::Result Deserializer::validate(const char* str,
+        std::size_t length) const noexcept {
+    Parser parser(str, length, m_limit);
+    parser.set_indexed(m_structural_index);
+
+    try {
+        parser.validating();
+    }
+    catch (const std::bad_alloc&) {
+        return {DeserializerError::OUT_OF_MEMORY, 0};
+    }
+    return {parser.get_error(), parser.get_error_offset()};
+}
+
+void Deserializer::parsing(const char* str, std::size_t length,
+        Handler& handler) {
+    Parser parser(str, length, m_limit);
+    parser.set_indexed(m_structural_index);
+    parser.parsing(handler);
+}
+
+void Deserializer::parsing_file(const char* path) {
+    parsing_file(path, m_value);
+}
+
+void Deserializer::parsing_file(const char* path, Value& value) {
+    MappedFile file(path);
+    parsing(file.data(), file.size(), value);
+}
+
+void Deserializer::parsing_file(const char* path, Handler& handler) {
+    MappedFile file(path);
+    parsing(file.data(), file.size(), handler);
+}
+
+json::Extraction operator>>(const char* str, json::Value& value) {
+    Deserializer().parsing(str, std::strlen(str), value);
+    return json::Extraction(value);
+}
+
+json::Extraction operator>>(const std::string& str, json::Value& value) {
+    Deserializer().parsing(str.c_str(), str.length(), value);
+    return json::Extraction(value);
 }
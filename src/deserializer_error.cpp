@@ -47,7 +47,7 @@
 
 using json::DeserializerError;
 
-static const std::array<const char*, 17> g_error_codes{{
+static const std::array<const char*, 22> g_error_codes{{
     "No error",
     "End of file reached",
     "Stack limit reached. Increase limit",
@@ -64,7 +64,12 @@ static const std::array<const char*, 17> g_error_codes{{
     "Invalid unicode",
     "Invalid number integer part",
     "Invalid number fractional part",
-    "Invalid number exponent part"
+    "Invalid number exponent part",
+    "Invalid control character in string. Use escape sequence",
+    "Invalid UTF-8 sequence",
+    "String limit reached. String must be shorter than 4 GiB",
+    "Tape limit reached. Increase limit or split document",
+    "Out of memory"
 }};
 
 DeserializerError::DeserializerError(Code code, std::size_t offset) :
@@ -0,0 +1,282 @@
+/*!
+ * @copyright
+ * Copyright (c) 2015, Tymoteusz Blazejczyk
+ *
+ * @copyright
+ * All rights reserved.
+ *
+ * @copyright
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * @copyright
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * @copyright
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * @copyright
+ * * Neither the name of json-cxx nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * @copyright
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file document.cpp
+ *
+ * @brief JSON document implementation
+ * */
+
+#include "json/document.hpp"
+#include "json/value_error.hpp"
+
+#include "parser.hpp"
+#include "mapped_file.hpp"
+
+using json::Node;
+using json::Value;
+using json::Parser;
+using json::MappedFile;
+using json::Document;
+
+/*! Maximum characters to parse per single JSON value. Stack protection */
+const std::size_t Document::DEFAULT_LIMIT_PER_OBJECT;
+
+std::size_t Node::size() const {
+    std::size_t value;
+
+    switch (m_type) {
+    case Type::OBJECT:
+        value = m_object.size;
+        break;
+    case Type::ARRAY:
+        value = m_array.size;
+        break;
+    case Type::STRING:
+    case Type::NIL:
+    case Type::NUMBER:
+    case Type::BOOLEAN:
+    default:
+        value = 0;
+        break;
+    }
+
+    return value;
+}
+
+const Node& Node::operator[](std::size_t index) const {
+    const Node* ptr;
+
+    if (is_array()) {
+        ptr = &m_array.data[index];
+    }
+    else if (is_object()) {
+        ptr = &m_object.data[index].value;
+    }
+    else {
+        ptr = this;
+    }
+
+    return *ptr;
+}
+
+const Node::Member* Node::find(const char* key) const {
+    const std::size_t length = std::strlen(key);
+
+    for (std::size_t i = 0; i < m_object.size; ++i) {
+        const Member& member = m_object.data[i];
+        /* Interned keys are found by address */
+        if ((member.key.size == length) && ((member.key.data == key)
+                    || (0 == std::memcmp(member.key.data, key, length)))) {
+            return &member;
+        }
+    }
+
+    return nullptr;
+}
+
+const Node& Node::operator[](const char* key) const {
+    static const Node null_node{};
+
+    if (!is_object()) { return *this; }
+
+    const Member* member = find(key);
+    if (nullptr != member) { return member->value; }
+
+    return null_node;
+}
+
+const char* Node::key(std::size_t index) const {
+    if (Type::OBJECT != m_type) {
+        throw ValueError(ValueError::NOT_OBJECT);
+    }
+    return m_object.data[index].key.data;
+}
+
+std::size_t Node::key_length(std::size_t index) const {
+    if (Type::OBJECT != m_type) {
+        throw ValueError(ValueError::NOT_OBJECT);
+    }
+    return m_object.data[index].key.size;
+}
+
+bool Node::is_member(const char* key) const {
+    if (!is_object()) { return false; }
+
+    return nullptr != find(key);
+}
+
+std::size_t Node::length() const {
+    if (Type::STRING != m_type) {
+        throw ValueError(ValueError::NOT_STRING);
+    }
+    return m_string.size;
+}
+
+const char* Node::as_char() const {
+    if (Type::STRING != m_type) {
+        throw ValueError(ValueError::NOT_STRING);
+    }
+    return m_string.data;
+}
+
+json::String Node::as_string() const {
+    if (Type::STRING != m_type) {
+        throw ValueError(ValueError::NOT_STRING);
+    }
+    return String(m_string.data, m_string.size);
+}
+
+json::Bool Node::as_bool() const {
+    if (Type::BOOLEAN != m_type) {
+        throw ValueError(ValueError::NOT_BOOLEAN);
+    }
+    return m_boolean;
+}
+
+json::Null Node::as_null() const {
+    if (Type::NIL != m_type) {
+        throw ValueError(ValueError::NOT_NULL);
+    }
+    return nullptr;
+}
+
+json::Int Node::as_int() const {
+    return Int(as_number());
+}
+
+json::Uint Node::as_uint() const {
+    return Uint(as_number());
+}
+
+json::Int64 Node::as_int64() const {
+    return Int64(as_number());
+}
+
+json::Uint64 Node::as_uint64() const {
+    return Uint64(as_number());
+}
+
+json::Double Node::as_double() const {
+    return Double(as_number());
+}
+
+const json::Number& Node::as_number() const {
+    if (Type::NUMBER != m_type) {
+        throw ValueError(ValueError::NOT_NUMBER);
+    }
+    return m_number;
+}
+
+Value Node::to_value() const {
+    Value value;
+
+    switch (m_type) {
+    case Type::OBJECT:
+        value = Value::Type::OBJECT;
+        for (std::size_t i = 0; i < m_object.size; ++i) {
+            const Member& member = m_object.data[i];
+            value.append(String(member.key.data, member.key.size),
+                    member.value.to_value());
+        }
+        break;
+    case Type::ARRAY:
+        value = Value::Type::ARRAY;
+        for (std::size_t i = 0; i < m_array.size; ++i) {
+            value.push_back(m_array.data[i].to_value());
+        }
+        break;
+    case Type::STRING:
+        value = String(m_string.data, m_string.size);
+        break;
+    case Type::NUMBER:
+        value = m_number;
+        break;
+    case Type::BOOLEAN:
+        value = m_boolean;
+        break;
+    case Type::NIL:
+    default:
+        break;
+    }
+
+    return value;
+}
+
+Document::Document(std::size_t chunk_size) :
+    m_arena(chunk_size),
+    m_root(),
+    m_limit{DEFAULT_LIMIT_PER_OBJECT},
+    m_structural_index{false},
+    m_keys{nullptr}
+{ }
+
+Document::Document(void* buffer, std::size_t size) :
+    m_arena(buffer, size),
+    m_root(),
+    m_limit{DEFAULT_LIMIT_PER_OBJECT},
+    m_structural_index{false},
+    m_keys{nullptr}
+{ }
+
+Document::~Document() { }
+
+void Document::clear() {
+    m_root = Node();
+    m_arena.clear();
+}
+
+void Document::parsing(const char* str, std::size_t length) {
+    clear();
+    Parser parser(str, length, m_limit);
+    parser.set_indexed(m_structural_index);
+    parser.set_key_table(m_keys);
+    parser.parsing(m_root, m_arena);
+}
+
+void Document::parsing_view(const char* str, std::size_t length) {
+    clear();
+    Parser parser(str, length, m_limit);
+    parser.set_indexed(m_structural_index);
+    parser.set_key_table(m_keys);
+    parser.parsing(m_root, m_arena, true);
+}
+
+void Document::parsing_file(const char* path) {
+    MappedFile file(path);
+    parsing(file.data(), file.size());
+}
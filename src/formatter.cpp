@@ -43,9 +43,47 @@
 
 #include "json/formatter.hpp"
 
+#include <algorithm>
+
 using json::Formatter;
 
 Formatter::Formatter(Writter* writter) :
-    m_writter(writter) { }
+    m_writter(writter),
+    m_buffer(),
+    m_length{0}
+{ }
 
 Formatter::~Formatter() { }
+
+void Formatter::flush() {
+    /* Reset first, buffer is not written twice when writter throws */
+    std::size_t length = m_length;
+    m_length = 0;
+
+    if ((nullptr != m_writter) && (0 != length)) {
+        m_writter->write(m_buffer.data(), length);
+    }
+}
+
+void Formatter::write(std::size_t count, char ch) {
+    while (count > 0) {
+        if (BUFFER_SIZE == m_length) { flush(); }
+
+        std::size_t chunk = std::min(count, BUFFER_SIZE - m_length);
+        std::memset(m_buffer.data() + m_length, ch, chunk);
+        m_length += chunk;
+        count -= chunk;
+    }
+}
+
+void Formatter::write_large(const char* str, std::size_t length) {
+    flush();
+
+    if (length < BUFFER_SIZE) {
+        std::memcpy(m_buffer.data(), str, length);
+        m_length = length;
+    }
+    else if (nullptr != m_writter) {
+        m_writter->write(str, length);
+    }
+}
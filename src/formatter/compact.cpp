@@ -43,11 +43,13 @@
 
 #include "json/formatter/compact.hpp"
 
+#include "grisu.hpp"
+#include "../simd.hpp"
+
 #include <array>
-#include <cmath>
-#include <limits>
 
 using json::formatter::Compact;
+using json::formatter::write_double;
 
 static constexpr std::size_t MAX_CHAR_BUFFER = 64;
 
@@ -60,7 +62,43 @@ static constexpr const char JSON_TRUE[] = "true";
 /*! JSON boolean false */
 static constexpr const char JSON_FALSE[] = "false";
 
-static constexpr const char NUMBER_CHARS[] = "0123456789";
+/*! Hexadecimal digits used by \\uXXXX escape sequences */
+static constexpr const char HEX_DIGITS[] = "0123456789ABCDEF";
+
+/*! Code point written in place of invalid UTF-8 sequence */
+static constexpr unsigned REPLACEMENT_CHARACTER = 0xFFFD;
+
+/*! Decimal digit pairs "00" to "99" */
+static constexpr const char DIGIT_PAIRS[] =
+    "0001020304050607080910111213141516171819"
+    "2021222324252627282930313233343536373839"
+    "4041424344454647484950515253545556575859"
+    "6061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+/*! Powers of ten 10^0 to 10^19 */
+static const std::array<json::Uint64, 20> g_pow10{{
+    1,
+    10,
+    100,
+    1000,
+    10000,
+    100000,
+    1000000,
+    10000000,
+    100000000,
+    1000000000,
+    10000000000,
+    100000000000,
+    1000000000000,
+    10000000000000,
+    100000000000000,
+    1000000000000000,
+    10000000000000000,
+    100000000000000000,
+    1000000000000000000,
+    10000000000000000000u
+}};
 
 Compact::Compact(Writter* writter) :
     Formatter(writter) { }
@@ -68,24 +106,25 @@ Compact::Compact(Writter* writter) :
 Compact::~Compact() { }
 
 void Compact::formatting(const json::Value& value) {
-    if (m_writter) {
+    if (nullptr != get_writter()) {
         write_value(value);
+        flush();
     }
 }
 
 void Compact::write_value(const Value& value) {
     switch (value.get_type()) {
     case Value::Type::OBJECT:
-        write_object(Object(value));
+        write_object(static_cast<const Object&>(value));
         break;
     case Value::Type::ARRAY:
-        write_array(Array(value));
+        write_array(static_cast<const Array&>(value));
         break;
     case Value::Type::STRING:
-        write_string(String(value));
+        write_string(static_cast<const String&>(value));
         break;
     case Value::Type::NUMBER:
-        write_number(Number(value));
+        write_number(static_cast<const Number&>(value));
         break;
     case Value::Type::BOOLEAN:
         write_boolean(Bool(value));
@@ -102,128 +141,209 @@ void Compact::write_object(const Object& object) {
     auto it_pos = object.cbegin();
     auto it_end = object.cend();
 
-    m_writter->write('{');
+    write('{');
     while (it_pos < it_end) {
         write_string(it_pos->first);
-        m_writter->write(':');
+        write(':');
         write_value(it_pos->second);
         if (++it_pos != it_end) {
-            m_writter->write(',');
+            write(',');
         }
     }
-    m_writter->write('}');
+    write('}');
 }
 
 void Compact::write_array(const Array& array) {
     auto it_pos = array.cbegin();
     auto it_end = array.cend();
 
-    m_writter->write('[');
+    write('[');
     while (it_pos < it_end) {
         write_value(*it_pos);
         if (++it_pos != it_end) {
-            m_writter->write(',');
+            write(',');
         }
     }
-    m_writter->write(']');
+    write(']');
 }
 
 void Compact::write_string(const String& str) {
-    std::size_t count = 0;
+    const char* pos = str.data();
+    const char* end = pos + str.size();
+
+    write('"');
+    while (pos < end) {
+        const char* special = m_escape_unicode ?
+            simd::find_string_special_ascii(pos, end) :
+            simd::find_string_special(pos, end);
+
+        write(pos, std::size_t(special - pos));
+        if (special == end) { break; }
+        pos = write_escape(special, end);
+    }
+    write('"');
+}
+
+const char* Compact::write_escape(const char* pos, const char* end) {
+    const unsigned char ch = static_cast<unsigned char>(*pos++);
 
-    for (const char& ch : str) {
-        if (('\\' == ch) || ('\"' == ch)) {
-            ++count;
+    switch (ch) {
+    case '"':
+    case '\\':
+        write('\\');
+        write(char(ch));
+        break;
+    case '\b':
+        write("\\b", 2);
+        break;
+    case '\f':
+        write("\\f", 2);
+        break;
+    case '\n':
+        write("\\n", 2);
+        break;
+    case '\r':
+        write("\\r", 2);
+        break;
+    case '\t':
+        write("\\t", 2);
+        break;
+    default:
+        if (ch < 0x80) {
+            write_unicode(ch);
+            break;
         }
-        ++count;
-    }
 
-    m_writter->write('"');
-    if (count == str.size()) {
-        m_writter->write(str);
-    }
-    else {
-        std::string tmp;
-        tmp.reserve(count);
-        for (const char& ch : str) {
-            if (('\\' == ch) || ('\"' == ch)) {
-                tmp.push_back('\\');
-            }
-            tmp.push_back(ch);
+        /* UTF-8 lead byte: number of continuation bytes and lowest code */
+        unsigned code;
+        std::size_t count;
+        unsigned min;
+
+        if ((ch >= 0xC2) && (ch <= 0xDF)) {
+            code = ch & 0x1Fu;
+            count = 1;
+            min = 0x80;
+        }
+        else if ((ch >= 0xE0) && (ch <= 0xEF)) {
+            code = ch & 0x0Fu;
+            count = 2;
+            min = 0x800;
+        }
+        else if ((ch >= 0xF0) && (ch <= 0xF4)) {
+            code = ch & 0x07u;
+            count = 3;
+            min = 0x10000;
+        }
+        else {
+            write_unicode(REPLACEMENT_CHARACTER);
+            break;
+        }
+
+        if (std::size_t(end - pos) < count) {
+            write_unicode(REPLACEMENT_CHARACTER);
+            break;
+        }
+
+        std::size_t i = 0;
+        for (; i < count; ++i) {
+            const unsigned char next = static_cast<unsigned char>(pos[i]);
+            if (0x80 != (next & 0xC0)) { break; }
+            code = (code << 6) | (next & 0x3Fu);
+        }
+
+        if ((i < count) || (code < min) || (code > 0x10FFFF)
+                || ((code >= 0xD800) && (code <= 0xDFFF))) {
+            write_unicode(REPLACEMENT_CHARACTER);
+            break;
+        }
+
+        pos += count;
+        if (code >= 0x10000) {
+            code -= 0x10000;
+            write_unicode(0xD800 | (code >> 10));
+            write_unicode(0xDC00 | (code & 0x3FFu));
+        }
+        else {
+            write_unicode(code);
         }
-        m_writter->write(tmp);
+        break;
     }
-    m_writter->write('"');
+
+    return pos;
+}
+
+void Compact::write_unicode(unsigned code) {
+    const char escape[6] = {
+        '\\', 'u',
+        HEX_DIGITS[(code >> 12) & 0xF],
+        HEX_DIGITS[(code >> 8) & 0xF],
+        HEX_DIGITS[(code >> 4) & 0xF],
+        HEX_DIGITS[code & 0xF]
+    };
+
+    write(escape, sizeof(escape));
 }
 
 void Compact::write_boolean(Bool value) {
     if (value) {
-        m_writter->write(JSON_TRUE, 4);
+        write(JSON_TRUE, 4);
     }
     else {
-        m_writter->write(JSON_FALSE, 5);
+        write(JSON_FALSE, 5);
     }
 }
 
 void Compact::write_empty() {
-    m_writter->write(JSON_NULL, 4);
+    write(JSON_NULL, 4);
 }
 
-static std::size_t write_number_uint(char* buffer, json::Uint64 value) {
-    std::size_t count = 0;
-    json::Uint64 tmp = value;
-
-    do {
-        ++count;
-        tmp /= 10;
-    } while (tmp);
-
-    char* pos = buffer + count;
-    do {
-        *(--pos) = NUMBER_CHARS[value % 10];
-        value /= 10;
-    } while (value);
+/*!
+ * @brief   Count decimal digits of value
+ *
+ * Bit length multiplied by 1233/4096 (approximation of log10(2)) is equal
+ * to the number of digits or it is one less
+ * */
+static inline
+std::size_t count_digits(json::Uint64 value) {
+    std::size_t bits = std::size_t(64 - __builtin_clzll(value | 1));
+    std::size_t digits = (bits * 1233) >> 12;
 
-    return count;
+    return digits + (((value | 1) >= g_pow10[digits]) ? 1 : 0);
 }
 
-static std::size_t write_number_int(char* buffer, json::Int64 value) {
-    std::size_t count = 0;
+static std::size_t write_number_uint(char* buffer, json::Uint64 value) {
+    std::size_t count = count_digits(value);
+    char* pos = buffer + count;
 
-    if (value < 0) {
-        buffer[0] = '-';
-        value = -value;
-        ++buffer;
-        ++count;
+    while (value >= 100) {
+        const char* pair = DIGIT_PAIRS + (2 * (value % 100));
+        value /= 100;
+        *(--pos) = pair[1];
+        *(--pos) = pair[0];
     }
 
-    count += write_number_uint(buffer, json::Uint64(value));
+    if (value >= 10) {
+        const char* pair = DIGIT_PAIRS + (2 * value);
+        *(--pos) = pair[1];
+        *(--pos) = pair[0];
+    }
+    else {
+        *(--pos) = char('0' + value);
+    }
 
     return count;
 }
 
-static std::size_t write_number_double(char* buffer, json::Double value) {
-    std::size_t count = 0;
+static std::size_t write_number_int(char* buffer, json::Int64 value) {
+    json::Uint64 magnitude = json::Uint64(value);
 
-    if (std::signbit(value)) {
+    if (value < 0) {
         buffer[0] = '-';
-        value = std::abs(value);
-        ++buffer;
-        ++count;
+        magnitude = 0 - magnitude;
+        return 1 + write_number_uint(buffer + 1, magnitude);
     }
 
-    count += write_number_uint(buffer, json::Uint64(value));
-    buffer += count;
-    buffer[count++] = '.';
-
-    double integral_part;
-    value = 10 * std::modf(value, &integral_part);
-    do {
-        buffer[count++] = NUMBER_CHARS[json::Uint64(value) % 10];
-        value = 10 * std::modf(value, &integral_part);
-    } while (value >= std::numeric_limits<json::Double>::epsilon());
-
-    return count;
+    return write_number_uint(buffer, magnitude);
 }
 
 void Compact::write_number(const Number& number) {
@@ -238,12 +358,12 @@ void Compact::write_number(const Number& number) {
         count = write_number_uint(buffer.data(), Uint64(number));
         break;
     case Number::Type::DOUBLE:
-        count = write_number_double(buffer.data(), Double(number));
+        count = write_double(buffer.data(), Double(number));
         break;
     default:
         count = 0;
         break;
     }
 
-    m_writter->write(buffer.data(), count);
+    write(buffer.data(), count);
 }
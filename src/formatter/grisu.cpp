@@ -0,0 +1,453 @@
+/*!
+ * @copyright
+ * Copyright (c) 2015, Tymoteusz Blazejczyk
+ *
+ * @copyright
+ * All rights reserved.
+ *
+ * @copyright
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * @copyright
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * @copyright
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * @copyright
+ * * Neither the name of json-cxx nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * @copyright
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file formatter/grisu.cpp
+ *
+ * @brief Shortest round-trip double to string conversion implementation
+ *
+ * Based on "Printing Floating-Point Numbers Quickly and Accurately with
+ * Integers" by Florian Loitsch. Grisu2 variant that uses boundaries of the
+ * rounding interval always produces number that reads back to the same
+ * double and in most cases it is also the shortest one
+ * */
+
+#include "grisu.hpp"
+
+#include <array>
+#include <cmath>
+#include <cstring>
+
+using json::Uint64;
+using json::Double;
+
+/*! Do-it-yourself floating-point number f * 2^e */
+struct DiyFp {
+    Uint64 f;
+    int e;
+};
+
+/*! Normalized 10^k approximation c = f * 2^e */
+struct CachedPower {
+    Uint64 f;
+    int e;
+    int k;
+};
+
+/*! Normalized double value with its rounding interval boundaries */
+struct Boundaries {
+    DiyFp w;
+    DiyFp minus;
+    DiyFp plus;
+};
+
+static constexpr int SIGNIFICAND_BITS = 52;
+static constexpr int EXPONENT_BIAS = 1075;
+static constexpr Uint64 HIDDEN_BIT = Uint64(1) << SIGNIFICAND_BITS;
+static constexpr Uint64 SIGNIFICAND_MASK = HIDDEN_BIT - 1;
+
+/*!
+ * Binary exponent range of cached power product, digits generation
+ * requires it to fit in a single 64-bit integer
+ * */
+static constexpr int ALPHA = -60;
+static constexpr int GAMMA = -32;
+
+static constexpr int CACHED_POWERS_MIN_DEC_EXP = -300;
+static constexpr int CACHED_POWERS_DEC_STEP = 8;
+
+/*! Fixed notation is used for decimal exponents in range [MIN_EXP, MAX_EXP) */
+static constexpr int MIN_EXP = -4;
+static constexpr int MAX_EXP = 15;
+
+static constexpr const char JSON_NULL[] = "null";
+
+/*! Rounded normalized powers of ten 10^k for k = -300, -292, ..., 324 */
+static const std::array<CachedPower, 79> g_cached_powers{{
+    {0xAB70FE17C79AC6CA, -1060, -300},
+    {0xFF77B1FCBEBCDC4F, -1034, -292},
+    {0xBE5691EF416BD60C, -1007, -284},
+    {0x8DD01FAD907FFC3C,  -980, -276},
+    {0xD3515C2831559A83,  -954, -268},
+    {0x9D71AC8FADA6C9B5,  -927, -260},
+    {0xEA9C227723EE8BCB,  -901, -252},
+    {0xAECC49914078536D,  -874, -244},
+    {0x823C12795DB6CE57,  -847, -236},
+    {0xC21094364DFB5637,  -821, -228},
+    {0x9096EA6F3848984F,  -794, -220},
+    {0xD77485CB25823AC7,  -768, -212},
+    {0xA086CFCD97BF97F4,  -741, -204},
+    {0xEF340A98172AACE5,  -715, -196},
+    {0xB23867FB2A35B28E,  -688, -188},
+    {0x84C8D4DFD2C63F3B,  -661, -180},
+    {0xC5DD44271AD3CDBA,  -635, -172},
+    {0x936B9FCEBB25C996,  -608, -164},
+    {0xDBAC6C247D62A584,  -582, -156},
+    {0xA3AB66580D5FDAF6,  -555, -148},
+    {0xF3E2F893DEC3F126,  -529, -140},
+    {0xB5B5ADA8AAFF80B8,  -502, -132},
+    {0x87625F056C7C4A8B,  -475, -124},
+    {0xC9BCFF6034C13053,  -449, -116},
+    {0x964E858C91BA2655,  -422, -108},
+    {0xDFF9772470297EBD,  -396, -100},
+    {0xA6DFBD9FB8E5B88F,  -369,  -92},
+    {0xF8A95FCF88747D94,  -343,  -84},
+    {0xB94470938FA89BCF,  -316,  -76},
+    {0x8A08F0F8BF0F156B,  -289,  -68},
+    {0xCDB02555653131B6,  -263,  -60},
+    {0x993FE2C6D07B7FAC,  -236,  -52},
+    {0xE45C10C42A2B3B06,  -210,  -44},
+    {0xAA242499697392D3,  -183,  -36},
+    {0xFD87B5F28300CA0E,  -157,  -28},
+    {0xBCE5086492111AEB,  -130,  -20},
+    {0x8CBCCC096F5088CC,  -103,  -12},
+    {0xD1B71758E219652C,   -77,   -4},
+    {0x9C40000000000000,   -50,    4},
+    {0xE8D4A51000000000,   -24,   12},
+    {0xAD78EBC5AC620000,     3,   20},
+    {0x813F3978F8940984,    30,   28},
+    {0xC097CE7BC90715B3,    56,   36},
+    {0x8F7E32CE7BEA5C70,    83,   44},
+    {0xD5D238A4ABE98068,   109,   52},
+    {0x9F4F2726179A2245,   136,   60},
+    {0xED63A231D4C4FB27,   162,   68},
+    {0xB0DE65388CC8ADA8,   189,   76},
+    {0x83C7088E1AAB65DB,   216,   84},
+    {0xC45D1DF942711D9A,   242,   92},
+    {0x924D692CA61BE758,   269,  100},
+    {0xDA01EE641A708DEA,   295,  108},
+    {0xA26DA3999AEF774A,   322,  116},
+    {0xF209787BB47D6B85,   348,  124},
+    {0xB454E4A179DD1877,   375,  132},
+    {0x865B86925B9BC5C2,   402,  140},
+    {0xC83553C5C8965D3D,   428,  148},
+    {0x952AB45CFA97A0B3,   455,  156},
+    {0xDE469FBD99A05FE3,   481,  164},
+    {0xA59BC234DB398C25,   508,  172},
+    {0xF6C69A72A3989F5C,   534,  180},
+    {0xB7DCBF5354E9BECE,   561,  188},
+    {0x88FCF317F22241E2,   588,  196},
+    {0xCC20CE9BD35C78A5,   614,  204},
+    {0x98165AF37B2153DF,   641,  212},
+    {0xE2A0B5DC971F303A,   667,  220},
+    {0xA8D9D1535CE3B396,   694,  228},
+    {0xFB9B7CD9A4A7443C,   720,  236},
+    {0xBB764C4CA7A44410,   747,  244},
+    {0x8BAB8EEFB6409C1A,   774,  252},
+    {0xD01FEF10A657842C,   800,  260},
+    {0x9B10A4E5E9913129,   827,  268},
+    {0xE7109BFBA19C0C9D,   853,  276},
+    {0xAC2820D9623BF429,   880,  284},
+    {0x80444B5E7AA7CF85,   907,  292},
+    {0xBF21E44003ACDD2D,   933,  300},
+    {0x8E679C2F5E44FF8F,   960,  308},
+    {0xD433179D9C8CB841,   986,  316},
+    {0x9E19DB92B4E31BA9,  1013,  324}
+}};
+
+static inline
+DiyFp subtract(const DiyFp& x, const DiyFp& y) {
+    return {x.f - y.f, x.e};
+}
+
+/*! Returns rounded upper 64 bits of 128-bit product */
+static inline
+DiyFp multiply(const DiyFp& x, const DiyFp& y) {
+    Uint64 x_low = x.f & 0xFFFFFFFF;
+    Uint64 x_high = x.f >> 32;
+    Uint64 y_low = y.f & 0xFFFFFFFF;
+    Uint64 y_high = y.f >> 32;
+
+    Uint64 low_low = x_low * y_low;
+    Uint64 low_high = x_low * y_high;
+    Uint64 high_low = x_high * y_low;
+    Uint64 high_high = x_high * y_high;
+
+    Uint64 middle = (low_low >> 32) + (low_high & 0xFFFFFFFF)
+        + (high_low & 0xFFFFFFFF) + (Uint64(1) << 31);
+
+    return {
+        high_high + (low_high >> 32) + (high_low >> 32) + (middle >> 32),
+        x.e + y.e + 64
+    };
+}
+
+static inline
+DiyFp normalize(const DiyFp& x) {
+    int shift = __builtin_clzll(x.f);
+    return {x.f << shift, x.e - shift};
+}
+
+static inline
+DiyFp normalize_to(const DiyFp& x, int e) {
+    return {x.f << (x.e - e), e};
+}
+
+/*!
+ * @brief Compute normalized double value w and boundaries m- and m+ of its
+ * rounding interval, all numbers between them round to w
+ * */
+static Boundaries compute_boundaries(Double value) {
+    Uint64 bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+
+    Uint64 significand = bits & SIGNIFICAND_MASK;
+    int exponent = int(bits >> SIGNIFICAND_BITS);
+
+    DiyFp v = (0 == exponent)
+        ? DiyFp{significand, 1 - EXPONENT_BIAS}
+        : DiyFp{significand | HIDDEN_BIT, exponent - EXPONENT_BIAS};
+
+    /* Interval is asymmetric for powers of two */
+    bool lower_is_closer = (0 == significand) && (exponent > 1);
+
+    DiyFp plus = normalize({(2 * v.f) + 1, v.e - 1});
+    DiyFp minus = lower_is_closer
+        ? DiyFp{(4 * v.f) - 1, v.e - 2}
+        : DiyFp{(2 * v.f) - 1, v.e - 1};
+
+    return {normalize(v), normalize_to(minus, plus.e), plus};
+}
+
+/*!
+ * @brief Find cached power c = 10^-k such that product with number with
+ * binary exponent e has binary exponent in range [ALPHA, GAMMA]
+ * */
+static const CachedPower& get_cached_power(int e) {
+    int f = ALPHA - e - 1;
+    int k = ((f * 78913) / (1 << 18)) + ((f > 0) ? 1 : 0);
+    int index = (-CACHED_POWERS_MIN_DEC_EXP + k
+            + (CACHED_POWERS_DEC_STEP - 1)) / CACHED_POWERS_DEC_STEP;
+
+    return g_cached_powers[std::size_t(index)];
+}
+
+/*! Return number of decimal digits and largest power of ten <= n */
+static int find_largest_pow10(std::uint32_t n, std::uint32_t& pow10) {
+    static constexpr std::array<std::uint32_t, 10> POW10{{
+        1, 10, 100, 1000, 10000, 100000, 1000000, 10000000,
+        100000000, 1000000000
+    }};
+
+    int digits = int(POW10.size());
+
+    while ((digits > 1) && (n < POW10[std::size_t(digits - 1)])) {
+        --digits;
+    }
+
+    pow10 = POW10[std::size_t(digits - 1)];
+
+    return digits;
+}
+
+/*!
+ * @brief Move last digit closer to w while it stays in safe interval
+ * */
+static void round_weed(char* buffer, std::size_t length, Uint64 dist,
+        Uint64 delta, Uint64 rest, Uint64 ten_k) {
+    while ((rest < dist) && ((delta - rest) >= ten_k)
+            && (((rest + ten_k) < dist)
+                || ((dist - rest) > ((rest + ten_k) - dist)))) {
+        --buffer[length - 1];
+        rest += ten_k;
+    }
+}
+
+/*!
+ * @brief Generate shortest digits of number from scaled interval
+ * [minus, plus] that are closest to w
+ * */
+static std::size_t generate_digits(char* buffer, int& decimal_exponent,
+        const DiyFp& minus, const DiyFp& w, const DiyFp& plus) {
+    Uint64 delta = subtract(plus, minus).f;
+    Uint64 dist = subtract(plus, w).f;
+
+    int shift = -plus.e;
+    Uint64 one = Uint64(1) << shift;
+
+    std::uint32_t integral = std::uint32_t(plus.f >> shift);
+    Uint64 fractional = plus.f & (one - 1);
+
+    std::size_t length = 0;
+    std::uint32_t pow10;
+    int n = find_largest_pow10(integral, pow10);
+
+    while (n > 0) {
+        std::uint32_t digit = integral / pow10;
+        integral %= pow10;
+
+        buffer[length++] = char('0' + digit);
+        --n;
+
+        Uint64 rest = (Uint64(integral) << shift) + fractional;
+        if (rest <= delta) {
+            decimal_exponent += n;
+            round_weed(buffer, length, dist, delta, rest,
+                    Uint64(pow10) << shift);
+            return length;
+        }
+
+        pow10 /= 10;
+    }
+
+    int m = 0;
+
+    while (true) {
+        fractional *= 10;
+        delta *= 10;
+        dist *= 10;
+
+        buffer[length++] = char('0' + (fractional >> shift));
+        fractional &= one - 1;
+        ++m;
+
+        if (fractional <= delta) { break; }
+    }
+
+    decimal_exponent -= m;
+    round_weed(buffer, length, dist, delta, fractional, one);
+
+    return length;
+}
+
+static std::size_t write_exponent(char* buffer, int exponent) {
+    std::size_t count = 0;
+
+    if (exponent < 0) {
+        buffer[count++] = '-';
+        exponent = -exponent;
+    }
+    else {
+        buffer[count++] = '+';
+    }
+
+    if (exponent >= 100) {
+        buffer[count++] = char('0' + (exponent / 100));
+        exponent %= 100;
+        buffer[count++] = char('0' + (exponent / 10));
+    }
+    else if (exponent >= 10) {
+        buffer[count++] = char('0' + (exponent / 10));
+    }
+    buffer[count++] = char('0' + (exponent % 10));
+
+    return count;
+}
+
+/*!
+ * @brief Place decimal point or exponent for digits d1...dk * 10^e
+ * */
+static std::size_t format_digits(char* buffer, std::size_t length,
+        int decimal_exponent) {
+    int k = int(length);
+    int n = k + decimal_exponent;
+
+    if ((k <= n) && (n <= MAX_EXP)) {
+        /* digits[000].0 */
+        std::memset(buffer + k, '0', std::size_t(n - k));
+        buffer[n] = '.';
+        buffer[n + 1] = '0';
+        return std::size_t(n + 2);
+    }
+
+    if ((0 < n) && (n <= MAX_EXP)) {
+        /* dig.its */
+        std::memmove(buffer + n + 1, buffer + n, std::size_t(k - n));
+        buffer[n] = '.';
+        return length + 1;
+    }
+
+    if ((MIN_EXP < n) && (n <= 0)) {
+        /* 0.[000]digits */
+        std::memmove(buffer + 2 - n, buffer, length);
+        buffer[0] = '0';
+        buffer[1] = '.';
+        std::memset(buffer + 2, '0', std::size_t(-n));
+        return std::size_t(2 - n) + length;
+    }
+
+    std::size_t count = length;
+
+    if (1 != k) {
+        /* d.igitse+123 */
+        std::memmove(buffer + 2, buffer + 1, length - 1);
+        buffer[1] = '.';
+        ++count;
+    }
+
+    buffer[count++] = 'e';
+    return count + write_exponent(buffer + count, n - 1);
+}
+
+std::size_t json::formatter::write_double(char* buffer, Double value) {
+    if (!std::isfinite(value)) {
+        std::memcpy(buffer, JSON_NULL, sizeof(JSON_NULL) - 1);
+        return sizeof(JSON_NULL) - 1;
+    }
+
+    std::size_t count = 0;
+
+    if (std::signbit(value)) {
+        buffer[count++] = '-';
+        value = -value;
+    }
+
+    if (value <= 0) {
+        buffer[count++] = '0';
+        buffer[count++] = '.';
+        buffer[count++] = '0';
+        return count;
+    }
+
+    Boundaries boundaries = compute_boundaries(value);
+    const CachedPower& cached = get_cached_power(boundaries.plus.e);
+    DiyFp c{cached.f, cached.e};
+
+    DiyFp w = multiply(boundaries.w, c);
+    DiyFp minus = multiply(boundaries.minus, c);
+    DiyFp plus = multiply(boundaries.plus, c);
+
+    /* Shrink interval by 1 ulp to stay inside it despite rounding errors */
+    ++minus.f;
+    --plus.f;
+
+    int decimal_exponent = -cached.k;
+    std::size_t length = generate_digits(buffer + count, decimal_exponent,
+            minus, w, plus);
+
+    return count + format_digits(buffer + count, length, decimal_exponent);
+}
@@ -0,0 +1,78 @@
+/*!
+ * @copyright
+ * Copyright (c) 2015, Tymoteusz Blazejczyk
+ *
+ * @copyright
+ * All rights reserved.
+ *
+ * @copyright
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * @copyright
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * @copyright
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * @copyright
+ * * Neither the name of json-cxx nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * @copyright
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file formatter/grisu.hpp
+ *
+ * @brief Shortest round-trip double to string conversion interface
+ * */
+
+#ifndef JSON_CXX_FORMATTER_GRISU_HPP
+#define JSON_CXX_FORMATTER_GRISU_HPP
+
+#include <json/number.hpp>
+
+#include <cstddef>
+
+namespace json {
+namespace formatter {
+
+/*! Minimal buffer size required by write_double() */
+static constexpr std::size_t DOUBLE_BUFFER_SIZE = 32;
+
+/*!
+ * @brief Write double as decimal that reads back to the same double
+ *
+ * Digits are generated with Grisu2 algorithm. Decimal is the shortest in
+ * most cases and it always round-trips. Rarely it has one more digit than
+ * needed, like 9.999999999999999e+22 for 1e23. Numbers with decimal
+ * exponent in range [-4, 15) are written in fixed notation, integral
+ * values always with ".0" suffix. Other numbers are written in exponent
+ * notation like 1.5e+300. NaN and infinity have no JSON representation and
+ * they are written as null
+ *
+ * @param[out]  buffer  Output buffer with at least DOUBLE_BUFFER_SIZE bytes
+ * @param[in]   value   Double number
+ *
+ * @return  Number of written characters
+ * */
+std::size_t write_double(char* buffer, Double value);
+
+}
+}
+
+#endif /* JSON_CXX_FORMATTER_GRISU_HPP */
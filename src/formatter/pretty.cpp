@@ -55,29 +55,29 @@ void Pretty::write_object(const Object& object) {
     auto it_end = object.cend();
 
     if (it_pos != it_end) {
-        m_writter->write('{');
+        write('{');
 
         ++m_level;
         std::size_t indent_length = m_indent * m_level;
         while (it_pos < it_end) {
-            m_writter->write('\n');
-            m_writter->write(indent_length, ' ');
+            write('\n');
+            write(indent_length, ' ');
             write_string(it_pos->first);
-            m_writter->write(" : ", 3);
+            write(" : ", 3);
             write_value(it_pos->second);
             if (++it_pos != it_end) {
-                m_writter->write(',');
+                write(',');
             }
         }
-        m_writter->write('\n');
+        write('\n');
 
         --m_level;
 
-        m_writter->write(m_indent * m_level, ' ');
-        m_writter->write('}');
+        write(m_indent * m_level, ' ');
+        write('}');
     }
     else {
-        m_writter->write("{}", 2);
+        write("{}", 2);
     }
 }
 
@@ -86,26 +86,26 @@ void Pretty::write_array(const Array& array) {
     auto it_end = array.cend();
 
     if (it_pos != it_end) {
-        m_writter->write('[');
+        write('[');
 
         ++m_level;
         std::size_t indent_length = m_indent * m_level;
         while (it_pos < it_end) {
-            m_writter->write('\n');
-            m_writter->write(indent_length, ' ');
+            write('\n');
+            write(indent_length, ' ');
             write_value(*it_pos);
             if (++it_pos != it_end) {
-                m_writter->write(',');
+                write(',');
             }
         }
-        m_writter->write('\n');
+        write('\n');
 
         --m_level;
 
-        m_writter->write(m_indent * m_level, ' ');
-        m_writter->write(']');
+        write(m_indent * m_level, ' ');
+        write(']');
     }
     else {
-        m_writter->write("[]", 2);
+        write("[]", 2);
     }
 }
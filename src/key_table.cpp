@@ -0,0 +1,131 @@
+/*!
+ * @copyright
+ * Copyright (c) 2015, Tymoteusz Blazejczyk
+ *
+ * @copyright
+ * All rights reserved.
+ *
+ * @copyright
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * @copyright
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * @copyright
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * @copyright
+ * * Neither the name of json-cxx nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * @copyright
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file key_table.cpp
+ *
+ * @brief JSON key table implementation
+ * */
+
+#include "json/key_table.hpp"
+#include "json/arena.hpp"
+
+#include <mutex>
+#include <unordered_set>
+
+using json::KeyTable;
+
+constexpr std::size_t KeyTable::DEFAULT_MAX_KEYS;
+constexpr std::size_t KeyTable::SHARDS;
+
+/*! Size of first arena chunk with keys of single shard */
+static constexpr std::size_t KEYS_CHUNK_SIZE = 4096;
+
+namespace {
+
+/*! Interned key, characters are stored in shard arena */
+struct Key {
+    const char* data;
+    std::size_t length;
+    std::uint64_t hash;
+};
+
+struct KeyHash {
+    std::size_t operator()(const Key& key) const noexcept {
+        return key.hash;
+    }
+};
+
+struct KeyEqual {
+    bool operator()(const Key& lhs, const Key& rhs) const noexcept {
+        return (lhs.length == rhs.length) &&
+            (0 == std::memcmp(lhs.data, rhs.data, lhs.length));
+    }
+};
+
+}
+
+/*! Part of table with its own lock */
+struct KeyTable::Shard {
+    Shard() : mutex{}, arena{KEYS_CHUNK_SIZE}, keys{} { }
+
+    std::mutex mutex;
+    Arena arena;
+    std::unordered_set<Key, KeyHash, KeyEqual> keys;
+};
+
+KeyTable::KeyTable(std::size_t max_keys) :
+    m_shards{new Shard[SHARDS]},
+    m_max_keys{max_keys},
+    m_size{0}
+{ }
+
+KeyTable::~KeyTable() { }
+
+const char* KeyTable::intern(const char* str, std::size_t length,
+        std::uint64_t hash) {
+    /* Low bits are used by hash table buckets, shard is chosen by high */
+    Shard& shard = m_shards[(hash >> 60) % SHARDS];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    auto it = shard.keys.find(Key{str, length, hash});
+    if (shard.keys.end() != it) { return it->data; }
+
+    /* Limit is shared by all shards, key place is reserved first */
+    if (m_size.fetch_add(1) >= m_max_keys) {
+        --m_size;
+        return nullptr;
+    }
+
+    try {
+        char* data = shard.arena.allocate<char>(length + 1);
+        std::memcpy(data, str, length);
+        data[length] = '\0';
+
+        shard.keys.insert(Key{data, length, hash});
+
+        return data;
+    }
+    catch (...) {
+        --m_size;
+        throw;
+    }
+}
+
+std::size_t KeyTable::size() const {
+    return m_size;
+}
@@ -0,0 +1,373 @@
+/*!
+ * @copyright
+ * Copyright (c) 2015, Tymoteusz Blazejczyk
+ *
+ * @copyright
+ * All rights reserved.
+ *
+ * @copyright
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * @copyright
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * @copyright
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * @copyright
+ * * Neither the name of json-cxx nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * @copyright
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file lines_deserializer.cpp
+ *
+ * @brief JSON lines deserializer implementation
+ * */
+
+#include "json/lines_deserializer.hpp"
+#include "json/deserializer_error.hpp"
+#include "parser.hpp"
+#include "simd.hpp"
+
+#include <deque>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <iterator>
+#include <algorithm>
+#include <condition_variable>
+#include <cerrno>
+#include <cstring>
+#include <system_error>
+
+using json::Value;
+using json::Parser;
+using json::LinesDeserializer;
+using Error = json::DeserializerError;
+
+/*! Number of records taken at once by worker */
+static constexpr std::size_t RECORDS_PER_BATCH = 32;
+
+/*! Blocks kept in memory: one parsed by workers and one being read */
+static constexpr std::size_t MAX_BLOCKS = 2;
+
+const std::size_t LinesDeserializer::DEFAULT_BLOCK_SIZE;
+
+struct LinesDeserializer::Block {
+    /*! Text read from file, empty when records point to the caller input */
+    std::string buffer{};
+    std::vector<Record> records{};
+    /*! Parsed values, used only when they are collected */
+    std::vector<Value> values{};
+    /*! Index of the first record from the input beginning */
+    std::size_t index{0};
+    /*! Records not parsed yet */
+    std::size_t pending{0};
+};
+
+LinesDeserializer::LinesDeserializer() : LinesDeserializer(0) { }
+
+LinesDeserializer::LinesDeserializer(std::size_t threads) :
+    m_threads{threads}
+{
+    if (0 == m_threads) {
+        m_threads = std::thread::hardware_concurrency();
+    }
+
+    if (0 == m_threads) {
+        m_threads = 1;
+    }
+}
+
+LinesDeserializer::~LinesDeserializer() { }
+
+void LinesDeserializer::parsing(const char* str, std::size_t length,
+        std::vector<Value>& values) {
+    run([&](Block& block) {
+        split(block, str, length, 0);
+        return false;
+    },
+    [&](Block& block, std::size_t index) {
+        const Record& record = block.records[index];
+
+        Parser(record.str, record.length, m_limit)
+            .parsing(block.values[index]);
+    },
+    [&](Block& block) {
+        values.insert(values.end(),
+                std::make_move_iterator(block.values.begin()),
+                std::make_move_iterator(block.values.end()));
+    });
+}
+
+void LinesDeserializer::parsing(const char* str, std::size_t length,
+        const Callback& callback) {
+    run([&](Block& block) {
+        split(block, str, length, 0);
+        return false;
+    },
+    [&](Block& block, std::size_t index) {
+        const Record& record = block.records[index];
+        Value value;
+
+        Parser(record.str, record.length, m_limit).parsing(value);
+        callback(block.index + index, value);
+    }, nullptr);
+}
+
+void LinesDeserializer::parsing(std::FILE* file,
+        std::vector<Value>& values) {
+    std::string rest;
+    std::size_t offset = 0;
+
+    run([&](Block& block) {
+        return reading(file, block, rest, offset);
+    },
+    [&](Block& block, std::size_t index) {
+        const Record& record = block.records[index];
+
+        Parser(record.str, record.length, m_limit)
+            .parsing(block.values[index]);
+    },
+    [&](Block& block) {
+        values.insert(values.end(),
+                std::make_move_iterator(block.values.begin()),
+                std::make_move_iterator(block.values.end()));
+    });
+}
+
+void LinesDeserializer::parsing(std::FILE* file, const Callback& callback) {
+    std::string rest;
+    std::size_t offset = 0;
+
+    run([&](Block& block) {
+        return reading(file, block, rest, offset);
+    },
+    [&](Block& block, std::size_t index) {
+        const Record& record = block.records[index];
+        Value value;
+
+        Parser(record.str, record.length, m_limit).parsing(value);
+        callback(block.index + index, value);
+    }, nullptr);
+}
+
+void LinesDeserializer::split(Block& block, const char* str,
+        std::size_t length, std::size_t offset) const {
+    const char* end = str + length;
+
+    while (str < end) {
+        const void* found = std::memchr(str, '\n', std::size_t(end - str));
+        const char* line = (nullptr != found) ?
+            static_cast<const char*>(found) : end;
+
+        if (simd::skip_whitespaces(str, line) < line) {
+            block.records.push_back(
+                    Record{str, std::size_t(line - str), offset});
+        }
+
+        offset += std::size_t(line - str) + 1;
+        str = line + 1;
+    }
+}
+
+/*!
+ * Workers are started once and take record batches from the queue, while
+ * the next block is read by the calling thread. Blocks are collected in
+ * the input order. On error, remaining records are skipped and error of
+ * the first failed record is thrown
+ * */
+void LinesDeserializer::run(const Source& source, const Task& task,
+        const Collect& collect) {
+    struct Batch {
+        Block* block;
+        std::size_t first;
+        std::size_t last;
+    };
+
+    std::mutex mutex;
+    std::condition_variable ready;
+    std::condition_variable done;
+    std::deque<Batch> batches;
+    std::deque<std::unique_ptr<Block>> blocks;
+    std::vector<std::thread> threads;
+    std::size_t queued = 0;
+    bool stop = false;
+    std::atomic<bool> failed{false};
+    std::size_t failed_index = std::numeric_limits<std::size_t>::max();
+    std::exception_ptr error{};
+
+    auto worker = [&]() {
+        std::unique_lock<std::mutex> lock(mutex);
+
+        for (;;) {
+            ready.wait(lock, [&]() { return stop || !batches.empty(); });
+            if (batches.empty()) { break; }
+
+            const Batch batch = batches.front();
+            batches.pop_front();
+            lock.unlock();
+
+            std::size_t index = batch.first;
+            std::exception_ptr exception{};
+
+            try {
+                for (; !failed && (index < batch.last); ++index) {
+                    task(*batch.block, index);
+                }
+            }
+            catch (const Error& e) {
+                exception = std::make_exception_ptr(Error(e.get_code(),
+                    batch.block->records[index].offset + e.get_offset()));
+            }
+            catch (...) {
+                exception = std::current_exception();
+            }
+
+            lock.lock();
+            if ((nullptr != exception) &&
+                    ((batch.block->index + index) < failed_index)) {
+                failed_index = batch.block->index + index;
+                error = exception;
+            }
+            if (nullptr != exception) { failed = true; }
+
+            batch.block->pending -= batch.last - batch.first;
+            if (0 == batch.block->pending) { done.notify_all(); }
+        }
+    };
+
+    /* Collect parsed blocks until no more than count are left */
+    auto finish = [&](std::size_t count) {
+        while (blocks.size() > count) {
+            Block& block = *blocks.front();
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                done.wait(lock, [&]() { return 0 == block.pending; });
+            }
+            if (!failed && collect) { collect(block); }
+            blocks.pop_front();
+        }
+    };
+
+    std::exception_ptr exception{};
+
+    try {
+        std::size_t index = 0;
+        bool more = true;
+
+        while (more && !failed) {
+            std::unique_ptr<Block> block{new Block};
+
+            block->index = index;
+            more = source(*block);
+            index += block->records.size();
+
+            if (!block->records.empty()) {
+                if (collect) { block->values.resize(block->records.size()); }
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    block->pending = block->records.size();
+                    for (std::size_t first = 0; first < block->pending;
+                            first += RECORDS_PER_BATCH) {
+                        batches.push_back(Batch{block.get(), first,
+                            std::min(first + RECORDS_PER_BATCH,
+                                    block->pending)});
+                        ++queued;
+                    }
+                    blocks.push_back(std::move(block));
+                }
+                ready.notify_all();
+
+                while (threads.size() < std::min(m_threads, queued)) {
+                    threads.emplace_back(worker);
+                }
+            }
+
+            finish(MAX_BLOCKS - 1);
+        }
+
+        finish(0);
+    }
+    catch (...) {
+        exception = std::current_exception();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stop = true;
+    }
+    ready.notify_all();
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    if (nullptr != error) {
+        std::rethrow_exception(error);
+    }
+
+    if (nullptr != exception) {
+        std::rethrow_exception(exception);
+    }
+}
+
+/*!
+ * Block always ends on the record boundary. Incomplete last record is
+ * moved to the beginning of the next block
+ * */
+bool LinesDeserializer::reading(std::FILE* file, Block& block,
+        std::string& rest, std::size_t& offset) const {
+    std::string& buffer = block.buffer;
+    std::size_t used = rest.size();
+    std::size_t end = 0;
+    bool more = true;
+
+    buffer.swap(rest);
+
+    while (more && (0 == end)) {
+        const std::size_t begin = used;
+
+        buffer.resize(used + m_block_size);
+        used += std::fread(&buffer[used], 1, m_block_size, file);
+
+        if (0 != std::ferror(file)) {
+            throw std::system_error(errno, std::system_category());
+        }
+
+        more = (0 == std::feof(file));
+        end = used;
+
+        if (more) {
+            while ((end > begin) && ('\n' != buffer[end - 1])) { --end; }
+            if (end == begin) { end = 0; }
+        }
+    }
+
+    rest.assign(buffer, end, used - end);
+    buffer.resize(end);
+
+    split(block, buffer.data(), end, offset);
+    offset += end;
+
+    return more;
+}
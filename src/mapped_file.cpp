@@ -0,0 +1,126 @@
+/*!
+ * @copyright
+ * Copyright (c) 2015, Tymoteusz Blazejczyk
+ *
+ * @copyright
+ * All rights reserved.
+ *
+ * @copyright
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * @copyright
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * @copyright
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * @copyright
+ * * Neither the name of json-cxx nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * @copyright
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file mapped_file.cpp
+ *
+ * @brief Read-only memory-mapped file implementation
+ * */
+
+#include "mapped_file.hpp"
+
+#include <cerrno>
+#include <system_error>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+using json::MappedFile;
+
+static constexpr std::size_t READ_SIZE = 65536;
+
+MappedFile::MappedFile(const char* path) {
+    int fd;
+
+    do {
+        fd = ::open(path, O_RDONLY | O_CLOEXEC);
+    } while ((fd < 0) && (EINTR == errno));
+
+    if (fd < 0) {
+        throw std::system_error(errno, std::generic_category());
+    }
+
+    try {
+        struct stat status;
+
+        if (0 != ::fstat(fd, &status)) {
+            throw std::system_error(errno, std::generic_category());
+        }
+
+        /* Pseudo-files like in procfs report zero size, they are read */
+        if (S_ISREG(status.st_mode) && (0 != status.st_size)) {
+            m_size = std::size_t(status.st_size);
+            m_mapping = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE,
+                    fd, 0);
+            if (MAP_FAILED == m_mapping) {
+                m_mapping = nullptr;
+                throw std::system_error(errno, std::generic_category());
+            }
+            /* Only a hint, parsing works without it */
+            ::madvise(m_mapping, m_size, MADV_SEQUENTIAL);
+            m_data = static_cast<const char*>(m_mapping);
+        }
+        else {
+            read(fd);
+        }
+    }
+    catch (...) {
+        ::close(fd);
+        throw;
+    }
+
+    ::close(fd);
+}
+
+MappedFile::~MappedFile() {
+    if (nullptr != m_mapping) {
+        ::munmap(m_mapping, m_size);
+    }
+}
+
+void MappedFile::read(int fd) {
+    std::size_t length = 0;
+    ssize_t count;
+
+    do {
+        m_buffer.resize(length + READ_SIZE);
+        count = ::read(fd, &m_buffer[length], READ_SIZE);
+
+        if (count < 0) {
+            if (EINTR == errno) { continue; }
+            throw std::system_error(errno, std::generic_category());
+        }
+
+        length += std::size_t(count);
+    } while (0 != count);
+
+    m_buffer.resize(length);
+    m_data = m_buffer.data();
+    m_size = length;
+}
@@ -0,0 +1,86 @@
+/*!
+ * @copyright
+ * Copyright (c) 2015, Tymoteusz Blazejczyk
+ *
+ * @copyright
+ * All rights reserved.
+ *
+ * @copyright
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * @copyright
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * @copyright
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * @copyright
+ * * Neither the name of json-cxx nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * @copyright
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file mapped_file.hpp
+ *
+ * @brief Read-only memory-mapped file interface
+ * */
+
+#ifndef JSON_CXX_MAPPED_FILE_HPP
+#define JSON_CXX_MAPPED_FILE_HPP
+
+#include <string>
+#include <cstddef>
+
+namespace json {
+
+/*!
+ * @brief Whole file mapped to memory for sequential reading
+ *
+ * Regular files are mapped without copying. Other files like pipes, that
+ * cannot be mapped, and regular files that report zero size, like procfs
+ * pseudo-files, are read to the buffer. Throws std::system_error on
+ * failure
+ * */
+class MappedFile {
+public:
+    MappedFile(const char* path);
+
+    const char* data() const { return m_data; }
+
+    std::size_t size() const { return m_size; }
+
+    ~MappedFile();
+private:
+    MappedFile(const MappedFile&) = delete;
+    MappedFile(MappedFile&&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile& operator=(MappedFile&&) = delete;
+
+    void read(int fd);
+
+    const char* m_data{nullptr};
+    std::size_t m_size{0};
+    void* m_mapping{nullptr};
+    /*! Content of file that cannot be mapped */
+    std::string m_buffer{};
+};
+
+}
+
+#endif /* JSON_CXX_MAPPED_FILE_HPP */
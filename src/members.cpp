@@ -0,0 +1,393 @@
+/*!
+ * @copyright
+ * Copyright (c) 2015, Tymoteusz Blazejczyk
+ *
+ * @copyright
+ * All rights reserved.
+ *
+ * @copyright
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * @copyright
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * @copyright
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * @copyright
+ * * Neither the name of json-cxx nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * @copyright
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file members.cpp
+ *
+ * @brief JSON object members index implementation
+ * */
+
+#include "json/value.hpp"
+
+#include <limits>
+#include <cstring>
+
+using json::Value;
+
+namespace {
+
+/*! FNV-1a offset basis */
+constexpr std::uint32_t FNV_OFFSET{2166136261u};
+
+/*! FNV-1a prime */
+constexpr std::uint32_t FNV_PRIME{16777619u};
+
+/*! Maximal number of members that can be indexed */
+constexpr std::size_t MAX_INDEXED{std::numeric_limits<std::uint32_t>::max()};
+
+inline std::uint32_t hash_update(std::uint32_t hash, char ch) {
+    return (hash ^ std::uint8_t(ch)) * FNV_PRIME;
+}
+
+inline std::uint32_t hash_key(const json::String& key) {
+    std::uint32_t hash = FNV_OFFSET;
+
+    for (char ch : key) { hash = hash_update(hash, ch); }
+
+    return hash;
+}
+
+}
+
+/*!
+ * @brief Open addressing hash table with linear probing
+ *
+ * Slots store key hash and member position in object. Keys are not copied,
+ * they are compared with members in object
+ * */
+class Value::Members::Index {
+public:
+    Index(const Members& members);
+
+    const Pair* find(const Members& members, const char* key) const;
+
+    void insert(const Members& members, std::size_t position);
+
+    /*!
+     * @brief Remove member from index
+     *
+     * Member must be still in members. Positions of following members are
+     * not changed, use shift() after member is erased
+     *
+     * @param[in]   members     Indexed members
+     * @param[in]   position    Member position
+     * */
+    void remove(const Members& members, std::size_t position);
+
+    /*!
+     * @brief Move positions of members back after members are erased
+     *
+     * @param[in]   position    Position of first member after erased ones
+     * @param[in]   count       Number of erased members
+     * */
+    void shift(std::size_t position, std::size_t count);
+
+    /*! Check if some members were not indexed because of duplicated key */
+    bool has_duplicates() const { return 0 != m_duplicates; }
+private:
+    struct Slot {
+        /*! Key hash */
+        std::uint32_t hash;
+        /*! Member position plus one, zero for empty slot */
+        std::uint32_t position;
+    };
+
+    static std::size_t slot_index(std::uint32_t hash, std::size_t mask) {
+        return (hash ^ (hash >> 16)) & mask;
+    }
+
+    void grow();
+
+    void insert(const Members& members, std::uint32_t hash,
+            std::size_t position);
+
+    std::vector<Slot> m_slots;
+    std::size_t m_size;
+    std::size_t m_duplicates;
+};
+
+Value::Members::Index::Index(const Members& members) :
+    m_slots(),
+    m_size{0},
+    m_duplicates{0}
+{
+    std::size_t capacity = 2 * INDEX_THRESHOLD;
+    while (capacity < 2 * members.size()) { capacity *= 2; }
+    m_slots.resize(capacity, Slot{0, 0});
+
+    for (std::size_t i = 0; i < members.size(); ++i) {
+        insert(members, hash_key(members[i].first), i);
+    }
+}
+
+const json::Pair* Value::Members::Index::find(const Members& members,
+        const char* key) const {
+    std::uint32_t hash = FNV_OFFSET;
+    const char* end = key;
+
+    while ('\0' != *end) { hash = hash_update(hash, *end++); }
+
+    const std::size_t length = std::size_t(end - key);
+    const std::size_t mask = m_slots.size() - 1;
+
+    for (std::size_t i = slot_index(hash, mask); 0 != m_slots[i].position;
+            i = (i + 1) & mask) {
+        if (m_slots[i].hash == hash) {
+            const Pair& pair = members[m_slots[i].position - 1];
+            if ((pair.first.size() == length) &&
+                    (0 == std::memcmp(pair.first.data(), key, length))) {
+                return &pair;
+            }
+        }
+    }
+
+    return nullptr;
+}
+
+void Value::Members::Index::insert(const Members& members,
+        std::size_t position) {
+    if (2 * (m_size + 1) > m_slots.size()) { grow(); }
+    insert(members, hash_key(members[position].first), position);
+}
+
+void Value::Members::Index::insert(const Members& members,
+        std::uint32_t hash, std::size_t position) {
+    const std::size_t mask = m_slots.size() - 1;
+    std::size_t i = slot_index(hash, mask);
+
+    for (; 0 != m_slots[i].position; i = (i + 1) & mask) {
+        /* Keep first member when key is duplicated */
+        if ((m_slots[i].hash == hash) &&
+                (members[m_slots[i].position - 1].first ==
+                 members[position].first)) {
+            ++m_duplicates;
+            return;
+        }
+    }
+
+    m_slots[i] = Slot{hash, std::uint32_t(position + 1)};
+    ++m_size;
+}
+
+void Value::Members::Index::remove(const Members& members,
+        std::size_t position) {
+    const std::uint32_t hash = hash_key(members[position].first);
+    const std::size_t mask = m_slots.size() - 1;
+    std::size_t i = slot_index(hash, mask);
+
+    while (m_slots[i].position != (position + 1)) {
+        if (0 == m_slots[i].position) { return; }
+        i = (i + 1) & mask;
+    }
+
+    /* Move back following slots from the same probe sequence */
+    for (std::size_t j = (i + 1) & mask; 0 != m_slots[j].position;
+            j = (j + 1) & mask) {
+        const std::size_t k = slot_index(m_slots[j].hash, mask);
+
+        /* Slot can be moved when its home is not in range (i, j] */
+        if (((j - k) & mask) >= ((j - i) & mask)) {
+            m_slots[i] = m_slots[j];
+            i = j;
+        }
+    }
+
+    m_slots[i] = Slot{0, 0};
+    --m_size;
+}
+
+void Value::Members::Index::shift(std::size_t position, std::size_t count) {
+    const std::uint32_t first = std::uint32_t(position);
+    const std::uint32_t delta = std::uint32_t(count);
+
+    /* Branchless, so loop is vectorized */
+    for (auto& slot : m_slots) {
+        slot.position -= (slot.position > first) ? delta : 0;
+    }
+}
+
+void Value::Members::Index::grow() {
+    std::vector<Slot> slots(2 * m_slots.size(), Slot{0, 0});
+    const std::size_t mask = slots.size() - 1;
+
+    for (const auto& slot : m_slots) {
+        if (0 != slot.position) {
+            std::size_t i = slot_index(slot.hash, mask);
+            while (0 != slots[i].position) { i = (i + 1) & mask; }
+            slots[i] = slot;
+        }
+    }
+
+    m_slots = std::move(slots);
+}
+
+Value::Members::Members() :
+    Object(),
+    m_index(nullptr)
+{ }
+
+Value::Members::Members(std::initializer_list<Pair> init_list) :
+    Object(init_list),
+    m_index(nullptr)
+{
+    reindex();
+}
+
+Value::Members::Members(const Members& other) :
+    Object(other),
+    m_index(nullptr)
+{
+    if (nullptr != other.m_index) {
+        m_index = new Index(*other.m_index);
+    }
+}
+
+Value::Members::Members(Members&& other) noexcept :
+    Object(std::move(other)),
+    m_index(other.m_index)
+{
+    other.m_index = nullptr;
+}
+
+Value::Members& Value::Members::operator=(const Members& other) {
+    if (this != &other) {
+        delete m_index;
+        m_index = nullptr;
+
+        Object::operator=(other);
+
+        if (nullptr != other.m_index) {
+            m_index = new Index(*other.m_index);
+        }
+    }
+    return *this;
+}
+
+Value::Members& Value::Members::operator=(Members&& other) noexcept {
+    if (this != &other) {
+        delete m_index;
+
+        Object::operator=(std::move(other));
+
+        m_index = other.m_index;
+        other.m_index = nullptr;
+    }
+    return *this;
+}
+
+Value::Members::~Members() {
+    delete m_index;
+}
+
+json::Pair* Value::Members::find(const char* key) {
+    return const_cast<Pair*>(static_cast<const Members&>(*this).find(key));
+}
+
+const json::Pair* Value::Members::find(const char* key) const {
+    if (nullptr != m_index) {
+        return m_index->find(*this, key);
+    }
+
+    for (const auto& pair : *this) {
+        if (pair.first == key) {
+            return &pair;
+        }
+    }
+
+    return nullptr;
+}
+
+Value& Value::Members::append(String key) {
+    emplace_back(std::move(key), nullptr);
+
+    if (nullptr != m_index) {
+        try {
+            m_index->insert(*this, size() - 1);
+        }
+        catch (...) {
+            pop_back();
+            reindex();
+            throw;
+        }
+    }
+    else if (INDEX_THRESHOLD <= size()) {
+        try {
+            reindex();
+        }
+        catch (...) {
+            pop_back();
+            throw;
+        }
+    }
+
+    return back().second;
+}
+
+json::Object::iterator Value::Members::erase(Object::const_iterator pos) {
+    return erase(pos, pos + 1);
+}
+
+json::Object::iterator Value::Members::erase(Object::const_iterator first,
+        Object::const_iterator last) {
+    const std::size_t position = std::size_t(first - cbegin());
+    const std::size_t count = std::size_t(last - first);
+
+    /* Index without duplicated keys is updated, otherwise rebuilt */
+    const bool update = (nullptr != m_index) && !m_index->has_duplicates()
+        && (INDEX_THRESHOLD <= (size() - count));
+
+    if (update) {
+        for (std::size_t i = position; i < (position + count); ++i) {
+            m_index->remove(*this, i);
+        }
+    }
+
+    const bool tail = (size() == (position + count));
+    auto it = Object::erase(first, last);
+
+    if (update) {
+        if (!tail) { m_index->shift(position + count, count); }
+    }
+    else if (nullptr != m_index) {
+        reindex();
+    }
+
+    return it;
+}
+
+void Value::Members::pop_back() {
+    erase(cend() - 1);
+}
+
+void Value::Members::reindex() {
+    delete m_index;
+    m_index = nullptr;
+
+    if ((INDEX_THRESHOLD <= size()) && (MAX_INDEXED > size())) {
+        m_index = new Index(*this);
+    }
+}
@@ -105,7 +105,7 @@ Number::operator Uint64() const {
         break;
     }
 
-    return Uint(value);
+    return value;
 }
 
 Number::operator Int64() const {
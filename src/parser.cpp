@@ -42,8 +42,18 @@
  * */
 
 #include "parser.hpp"
+#include "simd.hpp"
+
+#include "json/document.hpp"
+#include "json/handler.hpp"
+#include "json/tape.hpp"
+#include "json/key_table.hpp"
 
 #include <array>
+#include <algorithm>
+#include <limits>
+#include <iterator>
+#include <memory>
 #include <cstring>
 
 using json::Value;
@@ -53,140 +63,1299 @@ using Error = json::DeserializerError;
 /*! UTF-16 surrogate pair */
 using Surrogate = std::pair<unsigned, unsigned>;
 
-static constexpr const char JSON_NULL[] = "null";
-static constexpr const char JSON_TRUE[] = "true";
-static constexpr const char JSON_FALSE[] = "false";
-static constexpr const std::size_t UNICODE_LENGTH = 4;
+static constexpr const char JSON_NULL[] = "null";
+static constexpr const char JSON_TRUE[] = "true";
+static constexpr const char JSON_FALSE[] = "false";
+static constexpr const std::size_t UNICODE_LENGTH = 4;
+
+static constexpr const Surrogate SURROGATE_MIN(0xD800, 0xDC00);
+static constexpr const Surrogate SURROGATE_MAX(0xDBFF, 0xDFFF);
+
+static constexpr std::uint32_t HEX_0_9 = '0' - 0x0;
+static constexpr std::uint32_t HEX_A_F = 'A' - 0xA;
+static constexpr std::uint32_t HEX_a_f = 'a' - 0xA;
+
+static constexpr json::Uint64 MAX_MANTISSA =
+    std::numeric_limits<json::Uint64>::max();
+static constexpr json::Int64 MAX_EXPONENT = 0x10000;
+static constexpr unsigned DECIMAL_BASE = 10;
+
+static inline
+bool is_digit(char ch) { return ('0' <= ch) && (ch <= '9'); }
+
+/*! Character can be a part of number or literal */
+static inline
+bool is_token_character(char ch) {
+    return (('a' <= ch) && (ch <= 'z')) || (('A' <= ch) && (ch <= 'Z'))
+        || is_digit(ch) || ('+' == ch) || ('-' == ch) || ('.' == ch);
+}
+
+static inline
+bool is_whitespace(char ch) {
+    return (' ' == ch) || ('\n' == ch) || ('\r' == ch) || ('\t' == ch);
+}
+
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+#define JSON_CXX_SWAR_DIGITS
+static constexpr std::size_t SWAR_DIGITS = 8;
+static constexpr json::Uint64 SWAR_BASE = 100000000;
+static constexpr json::Uint64 SWAR_LIMIT = MAX_MANTISSA / SWAR_BASE / 10;
+
+/*!
+ * @brief   Check if all eight characters are decimal digits
+ * */
+static inline
+bool is_eight_digits(json::Uint64 chunk) {
+    return 0 == (((chunk & 0xF0F0F0F0F0F0F0F0)
+            | (((chunk + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4))
+            - 0x3333333333333333);
+}
+
+/*!
+ * @brief   Convert eight decimal digits at once, first digit in lowest byte
+ * */
+static inline
+json::Uint64 parse_eight_digits(json::Uint64 chunk) {
+    static constexpr json::Uint64 MASK = 0x000000FF000000FF;
+    static constexpr json::Uint64 MUL1 = 100 + (json::Uint64(1000000) << 32);
+    static constexpr json::Uint64 MUL2 = 1 + (json::Uint64(10000) << 32);
+
+    chunk -= 0x3030303030303030;
+    chunk = (chunk * 10) + (chunk >> 8);
+    return (((chunk & MASK) * MUL1) + (((chunk >> 16) & MASK) * MUL2)) >> 32;
+}
+#endif
+
+/*!
+ * @brief   Convert decimal number without fractional part to integer
+ * @return  false when number is not an integer or it doesn't fit in 64 bits
+ * */
+static bool decimal_to_integer(const json::Decimal& decimal,
+        json::Uint64& integer) {
+    if ((0 != decimal.fraction_length) || decimal.truncated
+            || (decimal.exponent < 0)) {
+        return false;
+    }
+
+    integer = decimal.mantissa;
+
+    if (0 != integer) {
+        for (json::Int64 i = 0; i < decimal.exponent; ++i) {
+            if (integer > (MAX_MANTISSA / DECIMAL_BASE)) { return false; }
+            integer *= DECIMAL_BASE;
+        }
+    }
+
+    return !decimal.negative || (integer <= (json::Uint64(1) << 63));
+}
+
+/*!
+ * @brief   Get string length without null termination '\0'
+ * @return  String length
+ * */
+template<std::size_t N>
+constexpr std::size_t string_length(const char (&)[N]) { return (N - 1); }
+
+/*!
+ * @brief Builder that creates JSON value tree
+ *
+ * Opened containers and their already parsed elements are kept on the
+ * members stack. When container ends, its elements are moved to it at once
+ * */
+class Parser::ValueBuilder {
+public:
+    ValueBuilder() :
+        m_stack{},
+        m_members{}
+    {
+        m_members.emplace_back(String(), nullptr);
+    }
+
+    Value& get_root() { return m_members.front().second; }
+
+    void null() { next(); }
+
+    void boolean(Bool boolean) {
+        Value& value = next();
+
+        value.m_storage.boolean = boolean;
+        value.m_storage.tag = Value::TAG_BOOLEAN;
+    }
+
+    void number(const Number& number) {
+        new (&next().m_number) Number(number);
+    }
+
+    void string(const char* str, std::size_t length) {
+        Value& value = next();
+
+        value.m_storage.string = new String(str, length);
+        value.m_storage.tag = Value::TAG_STRING;
+    }
+
+    void key(const char* str, std::size_t length) {
+        m_members.emplace_back(String(str, length), nullptr);
+    }
+
+    void element() {
+        m_members.emplace_back(String(), nullptr);
+    }
+
+    void begin_object() {
+        Value& value = next();
+
+        value.m_storage.object = new Value::Members();
+        value.m_storage.tag = Value::TAG_OBJECT;
+        m_stack.push_back(m_members.size() - 1);
+    }
+
+    void begin_array() {
+        Value& value = next();
+
+        value.m_storage.array = new Array();
+        value.m_storage.tag = Value::TAG_ARRAY;
+        m_stack.push_back(m_members.size() - 1);
+    }
+
+    void end_object();
+
+    void end_array();
+private:
+    /*!
+     * Value is stored in the last member added by key() or element().
+     * It is JSON null value without storage, so it is written in place
+     * */
+    Value& next() { return m_members.back().second; }
+
+    /*! Positions in m_members of opened JSON objects and arrays */
+    std::vector<std::size_t> m_stack;
+    /*! Opened JSON containers followed by their already parsed elements */
+    std::vector<Pair> m_members;
+};
+
+void Parser::ValueBuilder::end_object() {
+    auto first = m_members.begin() + std::ptrdiff_t(m_stack.back());
+    Value& container = (first++)->second;
+
+    container.m_storage.object->assign(std::make_move_iterator(first),
+            std::make_move_iterator(m_members.end()));
+    container.m_storage.object->reindex();
+
+    m_members.erase(first, m_members.end());
+    m_stack.pop_back();
+}
+
+void Parser::ValueBuilder::end_array() {
+    auto first = m_members.begin() + std::ptrdiff_t(m_stack.back());
+    Value& container = (first++)->second;
+
+    Array& array = *container.m_storage.array;
+
+    array.reserve(std::size_t(m_members.end() - first));
+    for (auto it = first; it < m_members.end(); ++it) {
+        array.push_back(std::move(it->second));
+    }
+
+    m_members.erase(first, m_members.end());
+    m_stack.pop_back();
+}
+
+/*!
+ * @brief Builder that creates read-only document nodes in arena
+ *
+ * Elements of opened containers are collected on the members stack. When
+ * container ends, its elements are copied to arena at once, so each
+ * container and string takes single arena allocation
+ * */
+class Parser::DocumentBuilder {
+public:
+    DocumentBuilder(Arena& arena, const char* begin, const char* end,
+            KeyTable* keys) :
+        m_arena(arena),
+        m_begin(begin),
+        m_end(end),
+        m_keys(keys),
+        m_cache{},
+        m_stack{},
+        m_members{}
+    {
+        m_members.emplace_back();
+    }
+
+    const Node& get_root() const { return m_members.front().value; }
+
+    void null() { }
+
+    void boolean(Bool boolean) {
+        Node& node = next();
+
+        node.m_type = Node::Type::BOOLEAN;
+        node.m_boolean = boolean;
+    }
+
+    void number(const Number& number) {
+        Node& node = next();
+
+        node.m_type = Node::Type::NUMBER;
+        node.m_number = number;
+    }
+
+    void string(const char* str, std::size_t length) {
+        Node& node = next();
+
+        node.m_type = Node::Type::STRING;
+        node.m_string = copy(str, length);
+    }
+
+    void key(const char* str, std::size_t length) {
+        m_members.emplace_back();
+        m_members.back().key = (nullptr != m_keys) ?
+            intern(str, length) : copy(str, length);
+    }
+
+    void element() {
+        m_members.emplace_back();
+    }
+
+    void begin_object() {
+        next().m_type = Node::Type::OBJECT;
+        m_stack.push_back(m_members.size() - 1);
+    }
+
+    void begin_array() {
+        next().m_type = Node::Type::ARRAY;
+        m_stack.push_back(m_members.size() - 1);
+    }
+
+    void end_object();
+
+    void end_array();
+private:
+    using Member = Node::Member;
+
+    DocumentBuilder(const DocumentBuilder&) = delete;
+    DocumentBuilder& operator=(const DocumentBuilder&) = delete;
+
+    /*! Node is stored in the last member added by key() or element() */
+    Node& next() { return m_members.back().value; }
+
+    /*!
+     * @brief Copy string to arena with null termination
+     *
+     * String that is part of referenced JSON text is not copied
+     * */
+    Node::Range<char> copy(const char* str, std::size_t length) {
+        if ((m_begin <= str) && (str < m_end)) {
+            return Node::Range<char>{str, length};
+        }
+
+        char* data = m_arena.allocate<char>(length + 1);
+
+        std::memcpy(data, str, length);
+        data[length] = '\0';
+
+        return Node::Range<char>{data, length};
+    }
+
+    /*!
+     * @brief Get key from shared key table
+     *
+     * Recently interned keys are cached locally, so repeated keys of
+     * homogeneous objects don't lock key table
+     * */
+    Node::Range<char> intern(const char* str, std::size_t length) {
+        const Uint64 hash = KeyTable::hash(str, length);
+        Node::Range<char>& cached = m_cache[hash % m_cache.size()];
+
+        if ((cached.size == length) && (nullptr != cached.data)
+                && (0 == std::memcmp(cached.data, str, length))) {
+            return cached;
+        }
+
+        const char* data = m_keys->intern(str, length, hash);
+        if (nullptr == data) { return copy(str, length); }
+
+        cached = Node::Range<char>{data, length};
+        return cached;
+    }
+
+    Arena& m_arena;
+    /*! JSON text referenced by strings, empty when strings are copied */
+    const char* m_begin;
+    const char* m_end;
+    /*! Shared key table, keys are copied when it is not set */
+    KeyTable* m_keys;
+    /*! Recently interned keys indexed by hash */
+    std::array<Node::Range<char>, 64> m_cache;
+    /*! Positions in m_members of opened JSON objects and arrays */
+    std::vector<std::size_t> m_stack;
+    /*! Opened JSON containers followed by their already parsed elements */
+    std::vector<Member> m_members;
+};
+
+void Parser::DocumentBuilder::end_object() {
+    auto first = m_members.begin() + std::ptrdiff_t(m_stack.back());
+    Node& container = (first++)->value;
+    const std::size_t size = std::size_t(m_members.end() - first);
+    Member* members = nullptr;
+
+    if (0 != size) {
+        members = m_arena.allocate<Member>(size);
+        std::uninitialized_copy(first, m_members.end(), members);
+    }
+
+    container.m_object = Node::Range<Member>{members, size};
+
+    m_members.erase(first, m_members.end());
+    m_stack.pop_back();
+}
+
+void Parser::DocumentBuilder::end_array() {
+    auto first = m_members.begin() + std::ptrdiff_t(m_stack.back());
+    Node& container = (first++)->value;
+    const std::size_t size = std::size_t(m_members.end() - first);
+    Node* nodes = nullptr;
+
+    if (0 != size) {
+        nodes = m_arena.allocate<Node>(size);
+        for (std::size_t i = 0; i < size; ++i) {
+            new (&nodes[i]) Node(first[std::ptrdiff_t(i)].value);
+        }
+    }
+
+    container.m_array = Node::Range<Node>{nodes, size};
+
+    m_members.erase(first, m_members.end());
+    m_stack.pop_back();
+}
+
+/*!
+ * @brief Builder that forwards parsed elements to user events handler
+ *
+ * Nothing is stored, so memory usage depends only on containers nesting
+ * */
+class Parser::HandlerBuilder {
+public:
+    HandlerBuilder(Handler& handler) : m_handler(handler) { }
+
+    void null() { m_handler.null(); }
+
+    void boolean(Bool boolean) { m_handler.boolean(boolean); }
+
+    void number(const Number& number) { m_handler.number(number); }
+
+    void string(const char* str, std::size_t length) {
+        m_handler.string(str, length);
+    }
+
+    void key(const char* str, std::size_t length) {
+        m_handler.key(str, length);
+    }
+
+    void element() { }
+
+    void begin_object() { m_handler.begin_object(); }
+
+    void begin_array() { m_handler.begin_array(); }
+
+    void end_object() { m_handler.end_object(); }
+
+    void end_array() { m_handler.end_array(); }
+private:
+    Handler& m_handler;
+};
+
+/*!
+ * @brief Builder that ignores all parsed elements
+ *
+ * Used only to check JSON text, nothing is allocated
+ * */
+class Parser::ValidateBuilder {
+public:
+    void null() { }
+
+    void boolean(Bool) { }
+
+    void number(const Number&) { }
+
+    void string(const char*, std::size_t) { }
+
+    void key(const char*, std::size_t) { }
+
+    void element() { }
+
+    void begin_object() { }
+
+    void begin_array() { }
+
+    void end_object() { }
+
+    void end_array() { }
+};
+
+/*!
+ * @brief Builder that writes JSON values to flat tape
+ *
+ * Container begin word is written when container begins and it is updated
+ * with skip index and elements count when container ends
+ * */
+class Parser::TapeBuilder {
+public:
+    TapeBuilder(Tape& tape, Parser& parser) :
+        m_words(tape.m_words),
+        m_strings(tape.m_strings),
+        m_words_limit(tape.m_words_limit),
+        m_stack{},
+        m_parser(parser)
+    { }
+
+    void null() { push(Tape::TAG_NULL); }
+
+    void boolean(Bool boolean) {
+        push(boolean ? Tape::TAG_TRUE : Tape::TAG_FALSE);
+    }
+
+    void number(const Number& number) {
+        switch (number.m_type) {
+        case Number::Type::INT:
+            push(Tape::TAG_INT);
+            m_words.push_back(Uint64(number.m_int));
+            break;
+        case Number::Type::UINT:
+            push(Tape::TAG_UINT);
+            m_words.push_back(number.m_uint);
+            break;
+        case Number::Type::DOUBLE:
+        default:
+            Uint64 bits;
+            std::memcpy(&bits, &number.m_double, sizeof(bits));
+            push(Tape::TAG_DOUBLE);
+            m_words.push_back(bits);
+            break;
+        }
+    }
+
+    void string(const char* str, std::size_t length) {
+        push(Tape::TAG_STRING, copy(str, length));
+    }
+
+    void key(const char* str, std::size_t length) {
+        ++m_stack.back().second;
+        push(Tape::TAG_STRING, copy(str, length));
+    }
+
+    void element() { ++m_stack.back().second; }
+
+    void begin_object() {
+        m_stack.emplace_back(m_words.size(), 0);
+        push(Tape::TAG_OBJECT);
+    }
+
+    void begin_array() {
+        m_stack.emplace_back(m_words.size(), 0);
+        push(Tape::TAG_ARRAY);
+    }
+
+    void end_object() { end(Tape::TAG_OBJECT, Tape::TAG_OBJECT_END); }
+
+    void end_array() { end(Tape::TAG_ARRAY, Tape::TAG_ARRAY_END); }
+private:
+    TapeBuilder(const TapeBuilder&) = delete;
+    TapeBuilder& operator=(const TapeBuilder&) = delete;
+
+    void push(Tape::Tag tag, Uint64 payload = 0) {
+        m_words.push_back(Tape::make_word(tag, payload));
+    }
+
+    /*!
+     * Copy string with its length and null termination. Length is stored
+     * on 32 bits, longer string is rejected
+     * */
+    Uint64 copy(const char* str, std::size_t length) {
+        if (length > std::numeric_limits<std::uint32_t>::max()) {
+            m_parser.throw_error(Error::STRING_LIMIT_REACHED);
+        }
+
+        const Uint64 offset = m_strings.size();
+        const std::uint32_t size = std::uint32_t(length);
+
+        m_strings.append(reinterpret_cast<const char*>(&size), sizeof(size));
+        m_strings.append(str, length);
+        m_strings.push_back('\0');
+
+        return offset;
+    }
+
+    /*!
+     * Index of the word after container end is stored on 32 bits, larger
+     * tape is rejected. Elements count saturates, TapeView counts
+     * elements of such container
+     * */
+    void end(Tape::Tag begin, Tape::Tag end) {
+        const std::size_t index = m_stack.back().first;
+        const Uint64 count = std::min<Uint64>(m_stack.back().second,
+                Tape::COUNT_MAX);
+
+        if (m_words.size() >= m_words_limit) {
+            m_parser.throw_error(Error::TAPE_LIMIT_REACHED);
+        }
+
+        m_stack.pop_back();
+        push(end, index);
+        m_words[index] = Tape::make_word(begin,
+                (count << Tape::COUNT_SHIFT) | m_words.size());
+    }
+
+    std::vector<Uint64>& m_words;
+    String& m_strings;
+    const std::size_t m_words_limit;
+    /*! Opened containers begin words and their elements count */
+    std::vector<std::pair<std::size_t, std::size_t>> m_stack;
+    Parser& m_parser;
+};
+
+Parser::Parser(const char* str, std::size_t length, std::size_t limit) :
+    m_begin{str},
+    m_current{str},
+    m_end{str + length},
+    m_limit{limit},
+    m_stack{},
+    m_string{},
+    m_state{State::BEGIN},
+    m_offset{0},
+    m_buffer{},
+    m_builder{},
+    m_indexed{false},
+    m_index{},
+    m_token{0},
+    m_keys{nullptr},
+    m_error{Error::NONE},
+    m_error_offset{0} { }
+
+Parser::~Parser() { }
+
+void Parser::parsing(Value& value) {
+    if (!try_parsing(value)) { throw_error(); }
+}
+
+bool Parser::try_parsing(Value& value) {
+    ValueBuilder builder;
+
+    value = nullptr;
+    if (!read_document(builder)) { return false; }
+    value = std::move(builder.get_root());
+    return true;
+}
+
+void Parser::parsing(Node& root, Arena& arena, bool views) {
+    DocumentBuilder builder(arena, views ? m_begin : nullptr,
+            views ? m_end : nullptr, m_keys);
+
+    if (!read_document(builder)) { throw_error(); }
+    root = builder.get_root();
+}
+
+void Parser::parsing(Handler& handler) {
+    HandlerBuilder builder(handler);
+
+    if (!read_document(builder)) { throw_error(); }
+}
+
+void Parser::parsing(Tape& tape) {
+    TapeBuilder builder(tape, *this);
+
+    if (!read_document(builder)) { throw_error(); }
+}
+
+/*!
+ * Grammar is checked first. UTF-8 encoding is checked next, up to the
+ * grammar error when there is one, so the first error is reported
+ * */
+bool Parser::validating() {
+    ValidateBuilder builder;
+    const bool valid = read_document(builder);
+    const char* end = valid ? m_end : (m_begin + m_error_offset);
+    const char* pos = simd::validate_utf8(m_begin, end);
+
+    if (pos < end) {
+        m_current = pos;
+        return fail(Error::INVALID_UTF8);
+    }
+
+    return valid;
+}
+
+bool Parser::parsing(const char* str, std::size_t length, bool last,
+        Value& value) {
+    const bool completed = (State::DONE == m_state);
+
+    if (nullptr == m_builder) {
+        m_builder.reset(new ValueBuilder);
+    }
+
+    if (!read_chunk(str, length, last, *m_builder)) { return false; }
+
+    if (!completed) {
+        value = std::move(m_builder->get_root());
+    }
+    return true;
+}
+
+bool Parser::parsing(const char* str, std::size_t length, bool last,
+        Handler& handler) {
+    HandlerBuilder builder(handler);
+
+    return read_chunk(str, length, last, builder);
+}
+
+/*!
+ * Only incomplete token is kept between chunks. It is completed with as
+ * few characters of the next chunk as needed, the rest of chunk is parsed
+ * in place without copying
+ * */
+template<typename Builder>
+bool Parser::read_chunk(const char* str, std::size_t length, bool last,
+        Builder& builder) {
+    std::size_t tail = 0;
+
+    if (!m_buffer.empty()) {
+        const std::size_t buffered = m_buffer.size();
+        std::size_t consumed = 0;
+
+        tail = read_token_tail(str, length);
+        m_buffer.append(str, tail);
+
+        for (;;) {
+            m_begin = m_buffer.data();
+            m_current = m_begin + consumed;
+            m_end = m_begin + m_buffer.size();
+
+            while (read_token(builder, last && (tail == length))) { }
+            consumed = std::size_t(m_current - m_begin);
+
+            if ((consumed == m_buffer.size()) || (tail == length)) { break; }
+
+            /* Token is longer than expected, take whole chunk */
+            m_buffer.append(str + tail, length - tail);
+            tail = length;
+        }
+
+        if (consumed < m_buffer.size()) {
+            m_buffer.erase(0, consumed);
+            m_offset += consumed;
+        }
+        else {
+            m_buffer.clear();
+            m_offset += buffered;
+        }
+    }
+
+    if (m_buffer.empty()) {
+        m_begin = str;
+        m_current = str + tail;
+        m_end = str + length;
+
+        while (read_token(builder, last)) { }
+
+        m_buffer.assign(m_current, m_end);
+        m_offset += std::size_t(m_current - m_begin);
+    }
+
+    if (last && (State::DONE != m_state)) {
+        if ((State::BEGIN != m_state) || !m_buffer.empty()) {
+            throw_error(Error::END_OF_FILE);
+        }
+        m_state = State::DONE;
+    }
+
+    return (State::DONE == m_state);
+}
+
+/*!
+ * Incomplete token is a string, a number or a literal. String ends with
+ * unescaped quote. Number or literal ends before the first character that
+ * can't be part of it, that character is also taken so number is not
+ * expected to continue
+ *
+ * @return  Number of chunk characters that complete token, chunk length
+ *          when token doesn't end in chunk
+ * */
+std::size_t Parser::read_token_tail(const char* str,
+        std::size_t length) const {
+    const char* end = str + length;
+    const char* pos = str;
+
+    if ('"' == m_buffer.front()) {
+        /* Odd number of trailing backslashes escapes first character */
+        bool escaped = false;
+        for (auto it = m_buffer.crbegin(); '\\' == *it; ++it) {
+            escaped = !escaped;
+        }
+        if (escaped) { ++pos; }
+
+        while (pos < end) {
+            pos = simd::find_string_special(pos, end);
+            if (pos >= end) { break; }
+            if ('\\' != *pos) { return std::size_t(pos - str) + 1; }
+            pos += 2;
+        }
+
+        return length;
+    }
+
+    while ((pos < end) && is_token_character(*pos)) { ++pos; }
+
+    return (pos < end) ? (std::size_t(pos - str) + 1) : length;
+}
+
+/*!
+ * Single token is parsed per call and builder gets events only when whole
+ * token is available. When chunk ends in the middle of token, parser
+ * position is restored to token beginning
+ *
+ * @return  false when more characters are needed
+ * */
+template<typename Builder>
+bool Parser::read_token(Builder& builder, bool last) {
+    const char* str;
+    std::size_t length;
+
+    read_whitespaces(false);
+    if (m_current >= m_end) { return false; }
+
+    const char* token = m_current;
+
+    try {
+        switch (m_state) {
+        case State::BEGIN:
+        case State::VALUE:
+            return read_token_value(builder, last);
+        case State::FIRST_VALUE:
+            if (']' == *m_current) {
+                ++m_current;
+                m_stack.pop_back();
+                builder.end_array();
+                read_token_end();
+            }
+            else {
+                builder.element();
+                m_state = State::VALUE;
+            }
+            break;
+        case State::FIRST_KEY:
+            if ('}' == *m_current) {
+                ++m_current;
+                m_stack.pop_back();
+                builder.end_object();
+                read_token_end();
+            }
+            else {
+                m_state = State::KEY;
+            }
+            break;
+        case State::KEY:
+            if ('"' != *m_current) { throw_error(Error::MISS_QUOTE); }
+            ++m_current;
+            if (!read_string(&str, length)) { throw_error(); }
+            builder.key(str, length);
+            m_state = State::COLON;
+            break;
+        case State::COLON:
+            if (':' != *m_current) { throw_error(Error::MISS_COLON); }
+            ++m_current;
+            m_state = State::VALUE;
+            break;
+        case State::NEXT:
+            read_token_next(builder);
+            break;
+        case State::DONE:
+        default:
+            throw_error(Error::INVALID_WHITESPACE);
+        }
+    }
+    catch (const Error& error) {
+        if (last || (Error::END_OF_FILE != error.get_code())) { throw; }
+        m_error = Error::NONE;
+        m_current = token;
+        return false;
+    }
+
+    return true;
+}
+
+template<typename Builder>
+bool Parser::read_token_value(Builder& builder, bool last) {
+    const char* token = m_current;
+    const char* str;
+    std::size_t length;
+    Number number;
+
+    switch (*m_current) {
+    case '"':
+        ++m_current;
+        if (!read_string(&str, length)) { throw_error(); }
+        builder.string(str, length);
+        break;
+    case '{':
+        ++m_current;
+        builder.begin_object();
+        m_stack.push_back(true);
+        m_state = State::FIRST_KEY;
+        return true;
+    case '[':
+        ++m_current;
+        builder.begin_array();
+        m_stack.push_back(false);
+        m_state = State::FIRST_VALUE;
+        return true;
+    case 't':
+        if (!read_true()) { throw_error(); }
+        builder.boolean(true);
+        break;
+    case 'f':
+        if (!read_false()) { throw_error(); }
+        builder.boolean(false);
+        break;
+    case 'n':
+        if (!read_null()) { throw_error(); }
+        builder.null();
+        break;
+    default:
+        if (('-' == *m_current) || std::isdigit(*m_current)) {
+            if (!read_number(number)) { throw_error(); }
+
+            /* Number may continue in the next chunk */
+            if (!last && (m_current >= m_end)) {
+                m_current = token;
+                return false;
+            }
+            builder.number(number);
+        }
+        else {
+            throw_error(Error::MISS_VALUE);
+        }
+        break;
+    }
+
+    read_token_end();
+    return true;
+}
+
+template<typename Builder>
+void Parser::read_token_next(Builder& builder) {
+    if (0 == m_limit--) { throw_error(Error::STACK_LIMIT_REACHED); }
+
+    if (',' == *m_current) {
+        ++m_current;
+        if (m_stack.back()) {
+            m_state = State::KEY;
+        }
+        else {
+            builder.element();
+            m_state = State::VALUE;
+        }
+        return;
+    }
+
+    if (m_stack.back()) {
+        if ('}' != *m_current) { throw_error(Error::MISS_CURLY_CLOSE); }
+        ++m_current;
+        m_stack.pop_back();
+        builder.end_object();
+    }
+    else {
+        if (']' != *m_current) { throw_error(Error::MISS_SQUARE_CLOSE); }
+        ++m_current;
+        m_stack.pop_back();
+        builder.end_array();
+    }
+
+    read_token_end();
+}
+
+void Parser::read_token_end() {
+    m_state = m_stack.empty() ? State::DONE : State::NEXT;
+}
+
+/*!
+ * Errors are returned, not thrown, so rejecting invalid JSON text costs
+ * no more than accepting valid one. Public parsing methods throw recorded
+ * error only once, at the end
+ *
+ * @return  false on error, code and offset are recorded by fail()
+ * */
+template<typename Builder>
+bool Parser::read_document(Builder& builder) {
+    bool reading = true;
+    bool is_container;
+
+    m_error = Error::NONE;
+
+    if (m_indexed && (std::size_t(m_end - m_begin)
+                <= std::numeric_limits<std::uint32_t>::max())) {
+        return read_indexed(builder);
+    }
+
+    read_whitespaces(false);
+    if (m_current >= m_end) { return true; }
+
+    while (reading) {
+        if (!read_value_begin(builder, is_container)) { return false; }
+
+        if (is_container) {
+            if (!read_element(builder)) { return false; }
+        }
+        else if (!read_value_end(builder, reading)) { return false; }
+    }
+
+    read_whitespaces(false);
+    if (m_current < m_end) {
+        return fail(Error::INVALID_WHITESPACE);
+    }
+
+    return true;
+}
+
+/*!
+ * Stage two of parsing with structural index. Tokens are taken from index,
+ * scalars and strings are read from their first character
+ * */
+template<typename Builder>
+bool Parser::read_indexed(Builder& builder) {
+    State state = State::VALUE;
+    const char* str;
+    std::size_t length;
+    char ch;
+
+    simd::index_structurals(m_begin, m_end, m_index);
+    m_token = 0;
+
+    if (m_index.empty()) { return true; }
+
+    while (State::DONE != state) {
+        if (!read_indexed_token(ch)) { return false; }
+
+        switch (state) {
+        case State::VALUE:
+            if (!read_indexed_value(builder, ch, state)) { return false; }
+            break;
+        case State::KEY:
+            if ('"' != ch) { return fail(Error::MISS_QUOTE); }
+            ++m_current;
+            if (!read_string(&str, length)) { return false; }
+            builder.key(str, length);
+            if (!read_indexed_token(ch)) { return false; }
+            if (':' != ch) { return fail(Error::MISS_COLON); }
+            state = State::VALUE;
+            break;
+        case State::NEXT:
+            if (!read_indexed_next(builder, ch, state)) { return false; }
+            break;
+        case State::BEGIN:
+        case State::FIRST_VALUE:
+        case State::FIRST_KEY:
+        case State::COLON:
+        case State::DONE:
+        default:
+            break;
+        }
+    }
+
+    if (m_token < m_index.size()) {
+        m_current = m_begin + m_index[m_token];
+        return fail(Error::INVALID_WHITESPACE);
+    }
+
+    return true;
+}
+
+template<typename Builder>
+bool Parser::read_indexed_value(Builder& builder, char ch, State& state) {
+    const char* str;
+    std::size_t length;
+
+    switch (ch) {
+    case '"':
+        ++m_current;
+        if (!read_string(&str, length)) { return false; }
+        builder.string(str, length);
+        break;
+    case '{':
+        ++m_current;
+        builder.begin_object();
+        if (!is_indexed_token('}')) {
+            m_stack.push_back(true);
+            state = State::KEY;
+            return true;
+        }
+        read_indexed_token(ch);
+        ++m_current;
+        builder.end_object();
+        break;
+    case '[':
+        ++m_current;
+        builder.begin_array();
+        if (!is_indexed_token(']')) {
+            m_stack.push_back(false);
+            builder.element();
+            state = State::VALUE;
+            return true;
+        }
+        read_indexed_token(ch);
+        ++m_current;
+        builder.end_array();
+        break;
+    case 't':
+        if (!read_true()) { return false; }
+        builder.boolean(true);
+        break;
+    case 'f':
+        if (!read_false()) { return false; }
+        builder.boolean(false);
+        break;
+    case 'n':
+        if (!read_null()) { return false; }
+        builder.null();
+        break;
+    default:
+        if (('-' == ch) || std::isdigit(ch)) {
+            if (!read_number_value(builder)) { return false; }
+        } else {
+            return fail(Error::MISS_VALUE);
+        }
+        break;
+    }
+
+    return read_indexed_end(state);
+}
+
+template<typename Builder>
+bool Parser::read_indexed_next(Builder& builder, char ch, State& state) {
+    if (0 == m_limit--) { return fail(Error::STACK_LIMIT_REACHED); }
+
+    if (',' == ch) {
+        if (m_stack.back()) {
+            state = State::KEY;
+        }
+        else {
+            builder.element();
+            state = State::VALUE;
+        }
+        return true;
+    }
+
+    if (m_stack.back()) {
+        if ('}' != ch) { return fail(Error::MISS_CURLY_CLOSE); }
+        ++m_current;
+        m_stack.pop_back();
+        builder.end_object();
+    }
+    else {
+        if (']' != ch) { return fail(Error::MISS_SQUARE_CLOSE); }
+        ++m_current;
+        m_stack.pop_back();
+        builder.end_array();
+    }
 
-static constexpr const Surrogate SURROGATE_MIN(0xD800, 0xDC00);
-static constexpr const Surrogate SURROGATE_MAX(0xDBFF, 0xDFFF);
+    return read_indexed_end(state);
+}
 
-static constexpr std::uint32_t HEX_0_9 = '0' - 0x0;
-static constexpr std::uint32_t HEX_A_F = 'A' - 0xA;
-static constexpr std::uint32_t HEX_a_f = 'a' - 0xA;
+/*!
+ * @param[out]  ch  First character of the next token
+ * */
+bool Parser::read_indexed_token(char& ch) {
+    if (m_token >= m_index.size()) {
+        m_current = m_end;
+        return fail(Error::END_OF_FILE);
+    }
 
-static const std::array<json::Uint64, 19> g_pow10{{
-    1,
-    10,
-    100,
-    1000,
-    10000,
-    100000,
-    1000000,
-    10000000,
-    100000000,
-    1000000000,
-    10000000000,
-    100000000000,
-    1000000000000,
-    10000000000000,
-    100000000000000,
-    1000000000000000,
-    10000000000000000,
-    100000000000000000,
-    1000000000000000000
-}};
-
-template<typename T>
-static inline
-T pow10(std::uint64_t index) { return T(g_pow10[index]); }
+    m_current = m_begin + m_index[m_token++];
+    ch = *m_current;
+    return true;
+}
+
+bool Parser::is_indexed_token(char ch) const {
+    return (m_token < m_index.size()) && (ch == m_begin[m_index[m_token]]);
+}
 
 /*!
- * @brief   Get string length without null termination '\0'
- * @return  String length
+ * Value must be followed by whitespace or by the next token, otherwise
+ * it has trailing characters that are not indexed separately
  * */
-template<std::size_t N>
-constexpr std::size_t string_length(const char (&)[N]) { return (N - 1); }
+bool Parser::read_indexed_end(State& state) {
+    if ((m_current < m_end)
+            && !is_whitespace(*m_current)
+            && ((m_token >= m_index.size())
+                || ((m_begin + m_index[m_token]) != m_current))) {
+        if (m_stack.empty()) { return fail(Error::INVALID_WHITESPACE); }
+        return fail(m_stack.back() ? Error::MISS_CURLY_CLOSE :
+                Error::MISS_SQUARE_CLOSE);
+    }
 
-Parser::Parser(const char* str, std::size_t length, std::size_t limit) :
-    m_begin{str},
-    m_current{str},
-    m_end{str + length},
-    m_limit{limit} { }
+    state = m_stack.empty() ? State::DONE : State::NEXT;
+    return true;
+}
 
-void Parser::parsing(Value& value) {
-    value = nullptr;
-    read_whitespaces(false);
-    if (m_current < m_end) {
-        read_value(value);
-        read_whitespaces(false);
-        if (m_current < m_end) {
-            throw_error(Error::INVALID_WHITESPACE);
+template<typename Builder>
+bool Parser::read_value_begin(Builder& builder, bool& is_container) {
+    const char* str;
+    std::size_t length;
+
+    is_container = false;
+
+    if (!read_whitespaces()) { return false; }
+
+    switch (*m_current) {
+    case '"':
+        ++m_current;
+        if (!read_string(&str, length)) { return false; }
+        builder.string(str, length);
+        break;
+    case '{':
+        ++m_current;
+        builder.begin_object();
+        if (!read_object(is_container)) { return false; }
+        if (!is_container) { builder.end_object(); }
+        break;
+    case '[':
+        ++m_current;
+        builder.begin_array();
+        if (!read_array(is_container)) { return false; }
+        if (!is_container) { builder.end_array(); }
+        break;
+    case 't':
+        if (!read_true()) { return false; }
+        builder.boolean(true);
+        break;
+    case 'f':
+        if (!read_false()) { return false; }
+        builder.boolean(false);
+        break;
+    case 'n':
+        if (!read_null()) { return false; }
+        builder.null();
+        break;
+    case '-':
+        if (!read_number_value(builder)) { return false; }
+        break;
+    default:
+        if (std::isdigit(*m_current)) {
+            if (!read_number_value(builder)) { return false; }
+        } else {
+            return fail(Error::MISS_VALUE);
         }
+        break;
     }
+
+    return true;
 }
 
-void Parser::read_object(Value& value) {
-    read_whitespaces();
+/*!
+ * @param[out]  reading     Cleared when whole JSON value is parsed
+ * */
+template<typename Builder>
+bool Parser::read_value_end(Builder& builder, bool& reading) {
+    while (!m_stack.empty()) {
+        if (!read_whitespaces()) { return false; }
+        if (0 == m_limit--) { return fail(Error::STACK_LIMIT_REACHED); }
 
-    value.m_type = Value::Type::OBJECT;
-    new (&value.m_object) Object();
+        if (',' == *m_current) {
+            ++m_current;
+            return read_element(builder);
+        }
 
-    if ('}' == *m_current) {
-        ++m_current;
-        return;
+        if (m_stack.back()) {
+            if ('}' != *m_current) { return fail(Error::MISS_CURLY_CLOSE); }
+            ++m_current;
+            m_stack.pop_back();
+            builder.end_object();
+        }
+        else {
+            if (']' != *m_current) { return fail(Error::MISS_SQUARE_CLOSE); }
+            ++m_current;
+            m_stack.pop_back();
+            builder.end_array();
+        }
     }
 
-    std::size_t count = 0;
-    read_object_member(value, count);
+    reading = false;
+    return true;
 }
 
-void Parser::read_object_member(Value& value, std::size_t& count) {
-    String key;
-    Value tmp;
+template<typename Builder>
+bool Parser::read_element(Builder& builder) {
+    const char* str;
+    std::size_t length;
 
-    read_quote();
-    read_string(key);
-    read_colon();
-    read_value(tmp);
-    read_whitespaces();
+    if (m_stack.back()) {
+        if (!read_quote() || !read_string(&str, length)) { return false; }
+        builder.key(str, length);
+        return read_colon();
+    }
 
-    ++count;
-    if (0 == m_limit--) { throw_error(Error::STACK_LIMIT_REACHED); }
+    builder.element();
+    return true;
+}
 
-    if (',' == *m_current) {
+/*!
+ * @param[out]  is_container    Set when object is not empty
+ * */
+bool Parser::read_object(bool& is_container) {
+    if (!read_whitespaces()) { return false; }
+
+    if ('}' == *m_current) {
         ++m_current;
-        read_object_member(value, count);
-        value.m_object[--count].first = std::move(key);
-        value.m_object[count].second = std::move(tmp);
+        is_container = false;
+        return true;
     }
-    else if ('}' == *m_current) {
-        ++m_current;
-        value.m_object.resize(count);
-        value.m_object[--count].first = std::move(key);
-        value.m_object[count].second = std::move(tmp);
 
-    }
-    else {
-        throw_error(Error::MISS_CURLY_CLOSE);
-    }
+    m_stack.push_back(true);
+    is_container = true;
+    return true;
 }
 
-void Parser::read_string(String& str) {
-    std::size_t capacity = 1;
-    char ch;
+bool Parser::read_string(const char** str, std::size_t& length) {
+    const char* pos = simd::find_string_special(m_current, m_end);
 
-    count_string_chars(capacity);
-    str.reserve(capacity);
+    /* Most of strings are without escapes, pass them directly from input */
+    if ((pos < m_end) && ('"' == *pos)) {
+        *str = m_current;
+        length = std::size_t(pos - m_current);
+        m_current = pos + 1;
+        return true;
+    }
+
+    m_string.clear();
+
+    while (pos < m_end) {
+        m_string.append(m_current, pos);
+        m_current = pos + 1;
 
-    while (m_current < m_end) {
-        ch = *(m_current++);
-        switch (ch) {
+        switch (*pos) {
         case '"':
-            return;
+            *str = m_string.data();
+            length = m_string.size();
+            return true;
         case '\\':
-            read_string_escape(str);
+            if (!read_string_escape(m_string)) { return false; }
             break;
         default:
-            str.push_back(ch);
-            break;
+            m_current = pos;
+            return fail(Error::INVALID_STRING_CHARACTER);
         }
+
+        pos = simd::find_string_special(m_current, m_end);
     }
 
-    throw_error(Error::END_OF_FILE);
+    m_current = pos;
+    return fail(Error::END_OF_FILE);
 }
 
-void Parser::read_string_escape(String& str) {
+bool Parser::read_string_escape(String& str) {
+    if (m_current >= m_end) {
+        return fail(Error::END_OF_FILE);
+    }
+
     char ch = *m_current;
 
     switch (ch) {
@@ -213,11 +1382,12 @@ void Parser::read_string_escape(String& str) {
         ++m_current;
         return read_string_unicode(str);
     default:
-        throw_error(Error::INVALID_ESCAPE);
+        return fail(Error::INVALID_ESCAPE);
     }
 
     ++m_current;
     str.push_back(ch);
+    return true;
 }
 
 static inline
@@ -227,15 +1397,15 @@ uint32_t decode_utf16_surrogate_pair(const Surrogate& surrogate) {
         |  (0x3FF & surrogate.second);
 }
 
-void Parser::read_string_unicode(String& str) {
+bool Parser::read_string_unicode(String& str) {
     Surrogate surrogate;
     uint32_t code;
 
-    read_unicode(&m_current, code);
+    if (!read_unicode(&m_current, code)) { return false; }
     if (m_current + 2 + UNICODE_LENGTH < m_end) {
         if (('\\' == m_current[0]) && ('u' == m_current[1])) {
             m_current += 2;
-            read_unicode(&m_current, surrogate.second);
+            if (!read_unicode(&m_current, surrogate.second)) { return false; }
             surrogate.first = code;
             if ((SURROGATE_MIN <= surrogate)
              && (SURROGATE_MAX >= surrogate)) {
@@ -270,11 +1440,12 @@ void Parser::read_string_unicode(String& str) {
         code_length = 4;
     }
     str.append(codes.data(), code_length);
+    return true;
 }
 
-void Parser::read_unicode(const char** pos, uint32_t& code) {
+bool Parser::read_unicode(const char** pos, uint32_t& code) {
     if (*pos + UNICODE_LENGTH >= m_end) {
-        throw_error(Error::END_OF_FILE);
+        return fail(Error::END_OF_FILE);
     }
 
     uint32_t ch;
@@ -294,335 +1465,375 @@ void Parser::read_unicode(const char** pos, uint32_t& code) {
             code |= (ch - HEX_a_f);
         }
         else {
-            throw_error(Error::INVALID_UNICODE);
+            return fail(Error::INVALID_UNICODE);
         }
         ++(*pos);
     }
+
+    return true;
 }
 
-void Parser::count_string_chars(std::size_t& count) {
-    const char* pos = m_current;
+/*!
+ * @param[out]  is_container    Set when array is not empty
+ * */
+bool Parser::read_array(bool& is_container) {
+    if (!read_whitespaces()) { return false; }
 
-    while (pos < m_end) {
-        switch (*pos) {
-        case '"':
-            return;
-        case '\\':
-            if ('u' == *(++pos)) {
-                uint32_t code;
-                read_unicode(&(++pos), code);
-                if (code < 0x80) { ++count; }
-                else if (code < 0x800) { count += 2; }
-                else {
-                    if ((SURROGATE_MIN.first > code)
-                     || (SURROGATE_MAX.first < code)) { count += 3; }
-                    else { count += 4; }
-                }
-            } else {
-                ++count;
-                ++pos;
-            }
-            break;
-        default:
-            ++count;
-            ++pos;
-            break;
-        }
+    if (']' == *m_current) {
+        ++m_current;
+        is_container = false;
+        return true;
     }
 
-    throw_error(Error::END_OF_FILE);
+    m_stack.push_back(false);
+    is_container = true;
+    return true;
 }
 
-void Parser::read_value(Value& value) {
-    read_whitespaces();
+bool Parser::read_colon() {
+    if (!read_whitespaces()) { return false; }
+    if (':' != *m_current) {
+        return fail(Error::MISS_COLON);
+    }
+    ++m_current;
+    return true;
+}
 
-    switch (*m_current) {
-    case '"': {
-        String str;
-        ++m_current;
-        read_string(str);
-        value.m_type = Value::Type::STRING;
-        new (&value.m_string) String(std::move(str));
-        break;
+bool Parser::read_quote() {
+    if (!read_whitespaces()) { return false; }
+    if ('"' != *m_current) {
+        return fail(Error::MISS_QUOTE);
     }
-    case '{':
-        ++m_current;
-        read_object(value);
-        break;
-    case '[':
-        ++m_current;
-        read_array(value);
-        break;
-    case 't':
-        read_true(value);
-        break;
-    case 'f':
-        read_false(value);
-        break;
-    case 'n':
-        read_null(value);
-        break;
-    case '-':
-        read_number(value);
-        break;
-    default:
-        if (std::isdigit(*m_current)) {
-            read_number(value);
-        } else {
-            throw_error(Error::MISS_VALUE);
-        }
-        break;
+    ++m_current;
+    return true;
+}
+
+bool Parser::read_whitespaces(bool enable_error) {
+    m_current = simd::skip_whitespaces(m_current, m_end);
+
+    if (enable_error && (m_current >= m_end)) {
+        return fail(Error::END_OF_FILE);
     }
+    return true;
 }
 
-void Parser::read_array(Value& value) {
-    read_whitespaces();
+/*!
+ * @param[out]  count   Number of digits stored in mantissa
+ * */
+bool Parser::read_number_digits(Decimal& decimal,
+        DeserializerError::Code code, std::size_t& count) {
+    static constexpr Uint64 MANTISSA_LIMIT = MAX_MANTISSA / DECIMAL_BASE;
+    static constexpr Uint64 DIGIT_LIMIT = MAX_MANTISSA % DECIMAL_BASE;
 
-    value.m_type = Value::Type::ARRAY;
-    new (&value.m_array) Array();
+    if (m_current >= m_end) {
+        return fail(Error::END_OF_FILE);
+    }
 
-    if (']' == *m_current) {
-        ++m_current;
-        return;
+    if (!is_digit(*m_current)) {
+        return fail(code);
     }
 
-    std::size_t count = 0;
-    read_array_element(value, count);
-}
+    const char* current = m_current;
+    Uint64 mantissa = decimal.mantissa;
+
+    if (!decimal.truncated) {
+#if defined(JSON_CXX_SWAR_DIGITS)
+        Uint64 chunk;
+        while ((std::size_t(m_end - current) >= SWAR_DIGITS)
+                && (mantissa < SWAR_LIMIT)) {
+            std::memcpy(&chunk, current, sizeof(chunk));
+            if (!is_eight_digits(chunk)) { break; }
+            mantissa = (SWAR_BASE * mantissa) + parse_eight_digits(chunk);
+            current += SWAR_DIGITS;
+        }
+#endif
 
-void Parser::read_array_element(Value& value, std::size_t& count)  {
-    Value tmp;
+        /* Mantissa can't overflow below the limit */
+        while ((current < m_end) && is_digit(*current)
+                && (mantissa < MANTISSA_LIMIT)) {
+            mantissa = (DECIMAL_BASE * mantissa) + Uint64(*current - '0');
+            ++current;
+        }
 
-    read_value(tmp);
-    read_whitespaces();
+        if ((current < m_end) && is_digit(*current)
+                && (mantissa == MANTISSA_LIMIT)
+                && (Uint64(*current - '0') <= DIGIT_LIMIT)) {
+            mantissa = (DECIMAL_BASE * mantissa) + Uint64(*current - '0');
+            ++current;
+        }
+    }
 
-    ++count;
-    if (0 == m_limit--) { throw_error(Error::STACK_LIMIT_REACHED); }
+    count = std::size_t(current - m_current);
 
-    if (',' == *m_current) {
-        ++m_current;
-        read_array_element(value, count);
-        value.m_array[--count] = std::move(tmp);
+    /* Remaining digits don't fit in mantissa */
+    while ((current < m_end) && is_digit(*current)) {
+        decimal.truncated = true;
+        ++current;
     }
-    else if (']' == *m_current) {
+
+    decimal.mantissa = mantissa;
+    m_current = current;
+
+    return true;
+}
+
+bool Parser::read_number_integer(Decimal& decimal) {
+    decimal.integer = m_current;
+
+    if ((m_current < m_end) && ('0' == *m_current)) {
         ++m_current;
-        value.m_array.resize(count);
-        value.m_array[--count] = std::move(tmp);
     }
     else {
-        throw_error(Error::MISS_SQUARE_CLOSE);
-    }
-}
+        std::size_t count;
 
-void Parser::read_colon() {
-    read_whitespaces();
-    if (':' != *m_current) {
-        throw_error(Error::MISS_COLON);
+        if (!read_number_digits(decimal, Error::INVALID_NUMBER_INTEGER,
+                    count)) {
+            return false;
+        }
+
+        /* Dropped integer digits scale mantissa up */
+        decimal.exponent += Int64(std::size_t(m_current - decimal.integer)
+                - count);
     }
-    ++m_current;
+
+    decimal.integer_length = std::size_t(m_current - decimal.integer);
+    return true;
 }
 
-void Parser::read_quote() {
-    read_whitespaces();
-    if ('"' != *m_current) {
-        throw_error(Error::MISS_QUOTE);
+bool Parser::read_number_fractional(Decimal& decimal) {
+    std::size_t count;
+
+    decimal.fraction = m_current;
+    if (!read_number_digits(decimal, Error::INVALID_NUMBER_FRACTION, count)) {
+        return false;
     }
-    ++m_current;
+    decimal.exponent -= Int64(count);
+    decimal.fraction_length = std::size_t(m_current - decimal.fraction);
+    return true;
 }
 
-void Parser::read_whitespaces(bool enable_error) {
-    char ch;
+bool Parser::read_number_exponent(Decimal& decimal) {
+    bool is_negative{false};
+    Int64 value{0};
 
-    while (m_current < m_end) {
-        ch = *m_current;
-        if ((' '  == ch) || ('\n' == ch) || ('\r' == ch) || ('\t' == ch)) {
+    if (m_current < m_end) {
+        if ('+' == *m_current) {
+            ++m_current;
+        } else if ('-' == *m_current) {
+            is_negative = true;
             ++m_current;
-        } else { return; }
+        }
     }
 
-    if (enable_error) {
-        throw_error(Error::END_OF_FILE);
+    if (m_current >= m_end) {
+        return fail(Error::END_OF_FILE);
     }
-}
 
-void Parser::read_number_digit(Uint64& value) {
-    if (m_current >= m_end) {
-        throw_error(Error::END_OF_FILE);
+    if (!is_digit(*m_current)) {
+        return fail(Error::INVALID_NUMBER_EXPONENT);
     }
 
-    if (std::isdigit(*m_current)) {
-        value = Uint64(*m_current - '0');
+    /* Saturate, such exponents always give zero or infinity */
+    do {
+        if (value < MAX_EXPONENT) {
+            value = (Int64(DECIMAL_BASE) * value) + (*m_current - '0');
+        }
         ++m_current;
-    }
-    else {
-        throw_error(Error::INVALID_NUMBER_INTEGER);
-    }
+    } while ((m_current < m_end) && is_digit(*m_current));
 
-    while (m_current < m_end) {
-        if (std::isdigit(*m_current)) {
-            value = (10 * value) + Uint64(*m_current - '0');
-            ++m_current;
-        } else { return; }
-    }
+    decimal.explicit_exponent = is_negative ? -value : value;
+    decimal.exponent += decimal.explicit_exponent;
+    return true;
 }
 
-void Parser::read_number_integer(Number& number) {
-    Uint64 value;
-    read_number_digit(value);
-
-    if (Number::Type::UINT == number.m_type) {
-        number.m_uint = value;
-    } else {
-        number.m_int = Int64(-value);
+bool Parser::read_decimal(Decimal& decimal) {
+    if ('-' == *m_current) {
+        decimal.negative = true;
+        ++m_current;
     }
-}
 
-void Parser::read_number_fractional(Number& number) {
-    std::size_t step{0};
-    Uint64 fractional{0};
+    if (!read_number_integer(decimal)) { return false; }
 
-    if (!std::isdigit(*m_current)) {
-        throw_error(Error::INVALID_NUMBER_FRACTION);
+    if ((m_current < m_end) && ('.' == *m_current)) {
+        ++m_current;
+        if (!read_number_fractional(decimal)) { return false; }
     }
 
-    while (m_current < m_end) {
-        if (std::isdigit(*m_current)) {
-            fractional = 10*fractional + Uint64(*(m_current++) - '0');
-            ++step;
-        }
-        else { break; }
+    if ((m_current < m_end) && (('E' == *m_current) || ('e' == *m_current))) {
+        ++m_current;
+        if (!read_number_exponent(decimal)) { return false; }
     }
 
-    if (Number::Type::UINT == number.m_type) {
-        Double tmp = Double(number.m_uint);
-        number.m_double = tmp + Double(fractional)/pow10<Double>(step);
-    } else {
-        Double tmp = Double(number.m_int);
-        number.m_double = tmp - Double(fractional)/pow10<Double>(step);
-    }
-    number.m_type = Number::Type::DOUBLE;
+    return true;
 }
 
-void Parser::read_number_exponent(Number& number) {
-    bool is_negative{false};
-    Uint64 value;
+/*!
+ * Integer and fractional digits are accumulated in one pass and mantissa
+ * is converted directly, without filling Decimal structure. Numbers with
+ * exponent part, too many digits or invalid syntax are left untouched
+ *
+ * @return  false when number must be read by read_decimal
+ * */
+inline bool Parser::read_short_number(Number& number) {
+    static constexpr std::size_t MAX_DIGITS = 19;
 
-    if ('+' == *m_current) {
-        ++m_current;
-    } else if ('-' == *m_current) {
-        is_negative = true;
-        ++m_current;
+    const char* current = m_current;
+    const bool negative = ('-' == *current);
+    if (negative) { ++current; }
+
+    const char* integer = current;
+    Uint64 mantissa = 0;
+
+    /* Overflow is harmless, such number is rejected by digits count */
+    while ((current < m_end) && is_digit(*current)) {
+        mantissa = (DECIMAL_BASE * mantissa) + Uint64(*current - '0');
+        ++current;
     }
 
-    read_number_digit(value);
+    const std::size_t integer_length = std::size_t(current - integer);
+    if ((0 == integer_length)
+            || ((integer_length > 1) && ('0' == *integer))) {
+        return false;
+    }
 
-    switch (number.m_type) {
-    case Number::Type::INT:
-        if (is_negative) {
-            number.m_double /= pow10<Double>(value);
-            number.m_type = Number::Type::DOUBLE;
-        } else {
-            number.m_int *= pow10<Int64>(value);
-        }
-        break;
-    case Number::Type::UINT:
-        if (is_negative) {
-            number.m_double /= pow10<Double>(value);
-            number.m_type = Number::Type::DOUBLE;
-        } else {
-            number.m_uint *= pow10<Uint64>(value);
-        }
-        break;
-    case Number::Type::DOUBLE:
-        if (is_negative) {
-            number.m_double /= pow10<Double>(value);
-        }
-        else {
-            number.m_double *= pow10<Double>(value);
+    std::size_t fraction_length = 0;
+    if ((current < m_end) && ('.' == *current)) {
+        const char* fraction = ++current;
+
+        while ((current < m_end) && is_digit(*current)) {
+            mantissa = (DECIMAL_BASE * mantissa) + Uint64(*current - '0');
+            ++current;
         }
-        break;
-    default:
-        break;
+
+        fraction_length = std::size_t(current - fraction);
+        if (0 == fraction_length) { return false; }
     }
-}
 
-void Parser::read_number(Value& value) {
-    /* Prepare JSON number */
-    value.m_type = Value::Type::NUMBER;
-    new (&value.m_number) Number();
+    if (((current < m_end) && (('E' == *current) || ('e' == *current)))
+            || ((integer_length + fraction_length) > MAX_DIGITS)) {
+        return false;
+    }
 
-    if ('-' == *m_current) {
-        value.m_number.m_type = Number::Type::INT;
-        value.m_number.m_int = 0;
-        ++m_current;
+    if (0 != fraction_length) {
+        number.m_type = Number::Type::DOUBLE;
+        number.m_double = decimal_to_double(mantissa,
+                -Int64(fraction_length), negative);
+    }
+    else if (!negative) {
+        number.m_type = Number::Type::UINT;
+        number.m_uint = mantissa;
+    }
+    else if (mantissa <= (Uint64(1) << 63)) {
+        number.m_type = Number::Type::INT;
+        number.m_int = Int64(-mantissa);
     }
     else {
-        value.m_number.m_type = Number::Type::UINT;
-        value.m_number.m_uint = 0;
+        return false;
     }
 
-    if ('0' == *m_current) {
-        ++m_current;
+    m_current = current;
+    return true;
+}
+
+bool Parser::read_number(Number& number) {
+    if (read_short_number(number)) { return true; }
+
+    Decimal decimal{};
+
+    if (!read_decimal(decimal)) { return false; }
+
+    Uint64 integer;
+    if (decimal_to_integer(decimal, integer)) {
+        if (decimal.negative) {
+            number.m_type = Number::Type::INT;
+            number.m_int = Int64(-integer);
+        }
+        else {
+            number.m_type = Number::Type::UINT;
+            number.m_uint = integer;
+        }
     }
     else {
-        read_number_integer(value.m_number);
+        number.m_type = Number::Type::DOUBLE;
+        number.m_double = decimal_to_double(decimal);
     }
 
-    if ('.' == *m_current) {
-        ++m_current;
-        read_number_fractional(value.m_number);
-    }
+    return true;
+}
 
-    if (('E' == *m_current) || ('e' == *m_current)) {
-        ++m_current;
-        read_number_exponent(value.m_number);
-    }
+template<typename Builder>
+bool Parser::read_number_value(Builder& builder) {
+    Number number;
+
+    if (!read_number(number)) { return false; }
+    builder.number(number);
+    return true;
+}
+
+/*!
+ * Only number syntax is checked, conversion to binary is skipped
+ * */
+bool Parser::read_number_value(ValidateBuilder&) {
+    Decimal decimal{};
+
+    return read_decimal(decimal);
 }
 
-void Parser::read_true(Value& value) {
+bool Parser::read_true() {
     if (m_current + string_length(JSON_TRUE) > m_end) {
-        throw_error(Error::END_OF_FILE);
+        return fail(Error::END_OF_FILE);
     }
 
     if (0 != std::strncmp(m_current, JSON_TRUE, string_length(JSON_TRUE))) {
-        throw_error(Error::NOT_MATCH_TRUE);
+        return fail(Error::NOT_MATCH_TRUE);
     }
 
-    value.m_type = Value::Type::BOOLEAN;
-    value.m_boolean = true;
-
     m_current += string_length(JSON_TRUE);
+    return true;
 }
 
-void Parser::read_false(Value& value) {
+bool Parser::read_false() {
     if (m_current + string_length(JSON_FALSE) > m_end) {
-        throw_error(Error::END_OF_FILE);
+        return fail(Error::END_OF_FILE);
     }
 
     if (0 != std::strncmp(m_current, JSON_FALSE, string_length(JSON_FALSE))) {
-        throw_error(Error::NOT_MATCH_FALSE);
+        return fail(Error::NOT_MATCH_FALSE);
     }
 
-    value.m_type = Value::Type::BOOLEAN;
-    value.m_boolean = false;
-
     m_current += string_length(JSON_FALSE);
+    return true;
 }
 
-void Parser::read_null(Value& value) {
+bool Parser::read_null() {
     if (m_current + string_length(JSON_NULL) > m_end) {
-        throw_error(Error::END_OF_FILE);
+        return fail(Error::END_OF_FILE);
     }
 
     if (0 != std::strncmp(m_current, JSON_NULL, string_length(JSON_NULL))) {
-        throw_error(Error::NOT_MATCH_NULL);
+        return fail(Error::NOT_MATCH_NULL);
     }
 
-    value.m_type = Value::Type::NIL;
-
     m_current += string_length(JSON_NULL);
+    return true;
+}
+
+/*!
+ * Error is recorded at position where parsing stopped
+ *
+ * @return  Always false, so failed reader can return it directly
+ * */
+bool Parser::fail(Error::Code code) {
+    m_error = code;
+    m_error_offset = m_offset + std::size_t(m_current - m_begin);
+    return false;
+}
+
+[[noreturn]] void Parser::throw_error() {
+    throw Error(m_error, m_error_offset);
 }
 
 [[noreturn]] void Parser::throw_error(Error::Code code) {
-    throw Error(code, std::size_t(m_current - m_begin));
+    fail(code);
+    throw_error();
 }
@@ -47,46 +47,250 @@
 #include <json/value.hpp>
 #include <json/deserializer_error.hpp>
 
+#include "decimal.hpp"
+
+#include <vector>
+#include <memory>
 #include <cstdint>
 
 namespace json {
 
+class Node;
+class Arena;
+class Handler;
+class Tape;
+class KeyTable;
+
+/*!
+ * @brief JSON parser
+ *
+ * Parser reads JSON text and passes parsed elements to builder that creates
+ * JSON value tree or document nodes. Containers are parsed iteratively,
+ * without recursion
+ * */
 class Parser {
 public:
     Parser(const char* str, std::size_t length, std::size_t limit);
 
+    ~Parser();
+
+    /*!
+     * @brief Select two-stage parsing with structural index
+     *
+     * Stage one classifies whole JSON text with SIMD and indexes all
+     * tokens. Stage two builds JSON values walking that index, without
+     * visiting whitespaces again
+     *
+     * @param[in]   indexed     Enable structural index
+     * */
+    void set_indexed(bool indexed) { m_indexed = indexed; }
+
+    /*!
+     * @brief Intern keys of parsed document nodes in shared table
+     *
+     * @param[in]   keys    Key table, nullptr to copy keys to arena
+     * */
+    void set_key_table(KeyTable* keys) { m_keys = keys; }
+
+    /*!
+     * @brief Parse JSON text to JSON value
+     *
+     * @param[out]  value   Parsed JSON value
+     * */
     void parsing(Value& value);
+
+    /*!
+     * @brief Parse JSON text to JSON value without throwing parsing errors
+     *
+     * Parsing error is returned through get_error() and get_error_offset()
+     *
+     * @param[out]  value   Parsed JSON value, JSON null value on error
+     *
+     * @return  true on success
+     * */
+    bool try_parsing(Value& value);
+
+    /*!
+     * @brief Check JSON text without building any JSON value
+     *
+     * Grammar, number syntax and UTF-8 encoding are checked. Numbers are
+     * not converted and no JSON value is allocated. Error is returned
+     * through get_error() and get_error_offset()
+     *
+     * @return  true when JSON text is valid
+     * */
+    bool validating();
+
+    /*! Error code of the last parsing, NONE on success */
+    DeserializerError::Code get_error() const { return m_error; }
+
+    /*! Offset in JSON text where the last parsing failed */
+    std::size_t get_error_offset() const { return m_error_offset; }
+
+    /*!
+     * @brief Parse JSON text to read-only document nodes
+     *
+     * @param[out]  root    Parsed document root node
+     * @param[in]   arena   Arena used for all nodes and strings
+     * @param[in]   views   Strings without escapes reference JSON text
+     *                      instead of being copied to arena
+     * */
+    void parsing(Node& root, Arena& arena, bool views = false);
+
+    /*!
+     * @brief Parse JSON text and pass parsing events to handler
+     *
+     * @param[in]   handler Events handler, no JSON value is created
+     * */
+    void parsing(Handler& handler);
+
+    /*!
+     * @brief Parse JSON text to flat tape
+     *
+     * @param[out]  tape    Tape with parsed JSON text
+     * */
+    void parsing(Tape& tape);
+
+    /*!
+     * @brief Parse next chunk of JSON text to JSON value
+     *
+     * Parser keeps its state and incomplete token between calls
+     *
+     * @param[in]   str     Next chunk of JSON text
+     * @param[in]   length  Chunk length
+     * @param[in]   last    Set when no more chunks will be passed
+     * @param[out]  value   Parsed JSON value, set when document completes
+     *
+     * @return  true when JSON document is complete
+     * */
+    bool parsing(const char* str, std::size_t length, bool last,
+            Value& value);
+
+    /*!
+     * @brief Parse next chunk of JSON text and pass parsing events to handler
+     *
+     * Parser keeps its state and incomplete token between calls. Handler
+     * receives events only for completely parsed tokens
+     *
+     * @param[in]   str     Next chunk of JSON text
+     * @param[in]   length  Chunk length
+     * @param[in]   last    Set when no more chunks will be passed
+     * @param[in]   handler Events handler
+     *
+     * @return  true when JSON document is complete
+     * */
+    bool parsing(const char* str, std::size_t length, bool last,
+            Handler& handler);
 private:
+    class ValueBuilder;
+    class DocumentBuilder;
+    class HandlerBuilder;
+    class TapeBuilder;
+    class ValidateBuilder;
+
+    /*! Next expected token during incremental parsing */
+    enum class State {
+        BEGIN,
+        VALUE,
+        FIRST_VALUE,
+        FIRST_KEY,
+        KEY,
+        COLON,
+        NEXT,
+        DONE
+    };
+
+    Parser(const Parser&) = delete;
+    Parser(Parser&&) = delete;
+    Parser& operator=(const Parser&) = delete;
+    Parser& operator=(Parser&&) = delete;
+
     const char* m_begin;
     const char* m_current;
     const char* m_end;
     std::size_t m_limit;
+    /*! Opened JSON containers, true for JSON object */
+    std::vector<bool> m_stack;
+    /*! Decoded JSON string that contains escapes */
+    String m_string;
+    /*! Incremental parsing state */
+    State m_state;
+    /*! Characters consumed from previous chunks */
+    std::size_t m_offset;
+    /*! Incomplete token from previous chunks */
+    String m_buffer;
+    /*! JSON value under construction during incremental parsing */
+    std::unique_ptr<ValueBuilder> m_builder;
+    /*! Two-stage parsing with structural index */
+    bool m_indexed;
+    /*! Token offsets from structural index */
+    std::vector<std::uint32_t> m_index;
+    /*! Next token in structural index */
+    std::size_t m_token;
+    /*! Shared table with interned keys */
+    KeyTable* m_keys;
+    /*! Last parsing error, NONE after successful parsing */
+    DeserializerError::Code m_error;
+    /*! Offset of last parsing error */
+    std::size_t m_error_offset;
 
-    void read_object(Value& value);
-    void read_object_member(Value& value, std::size_t& count);
-    void read_string(String& str);
-    void read_string_unicode(String& str);
-    void read_string_escape(String& str);
-    void read_value(Value& value);
-    void read_array(Value& value);
-    void read_array_element(Value& value, std::size_t& count);
-    void read_colon();
-    void read_quote();
-    void read_true(Value& value);
-    void read_false(Value& value);
-    void read_null(Value& value);
-    void read_number(Value& value);
-    void read_number_digit(Uint64& str);
-    void read_number_integer(Number& number);
-    void read_number_fractional(Number& number);
-    void read_number_exponent(Number& number);
-    void read_unicode(const char** pos, std::uint32_t& code);
-    void read_whitespaces(bool enable_error = true);
-    void count_string_chars(std::size_t& count);
+    template<typename Builder>
+    bool read_document(Builder& builder);
+    template<typename Builder>
+    bool read_value_begin(Builder& builder, bool& is_container);
+    template<typename Builder>
+    bool read_value_end(Builder& builder, bool& reading);
+    template<typename Builder>
+    bool read_element(Builder& builder);
+    template<typename Builder>
+    bool read_indexed(Builder& builder);
+    template<typename Builder>
+    bool read_indexed_value(Builder& builder, char ch, State& state);
+    template<typename Builder>
+    bool read_indexed_next(Builder& builder, char ch, State& state);
+    bool read_indexed_token(char& ch);
+    bool is_indexed_token(char ch) const;
+    bool read_indexed_end(State& state);
+    template<typename Builder>
+    bool read_chunk(const char* str, std::size_t length, bool last,
+            Builder& builder);
+    std::size_t read_token_tail(const char* str, std::size_t length) const;
+    template<typename Builder>
+    bool read_token(Builder& builder, bool last);
+    template<typename Builder>
+    bool read_token_value(Builder& builder, bool last);
+    template<typename Builder>
+    void read_token_next(Builder& builder);
+    void read_token_end();
 
+    bool read_string(const char** str, std::size_t& length);
+    bool read_string_unicode(String& str);
+    bool read_string_escape(String& str);
+    bool read_object(bool& is_container);
+    bool read_array(bool& is_container);
+    bool read_colon();
+    bool read_quote();
+    bool read_true();
+    bool read_false();
+    bool read_null();
+    bool read_decimal(Decimal& decimal);
+    bool read_number(Number& number);
+    bool read_short_number(Number& number);
+    template<typename Builder>
+    bool read_number_value(Builder& builder);
+    bool read_number_value(ValidateBuilder& builder);
+    bool read_number_digits(Decimal& decimal,
+            DeserializerError::Code code, std::size_t& count);
+    bool read_number_integer(Decimal& decimal);
+    bool read_number_fractional(Decimal& decimal);
+    bool read_number_exponent(Decimal& decimal);
+    bool read_unicode(const char** pos, std::uint32_t& code);
+    bool read_whitespaces(bool enable_error = true);
+
+    bool fail(DeserializerError::Code code);
+    [[noreturn]] void throw_error();
     [[noreturn]] void throw_error(DeserializerError::Code code);
 };
-
 }
 
 #endif /* JSON_CXX_PARSER_HPP */
@@ -45,12 +45,57 @@
 
 #include "json/formatter/compact.hpp"
 #include "json/writter/string.hpp"
+#include "json/writter/counter.hpp"
+
+#include <cstring>
 
 using json::Serializer;
 
+namespace {
+
+/*!
+ * @brief Writter that passes data straight to output stream
+ *
+ * Formatter already buffers its output, so no second buffer is needed.
+ * Output stream is never flushed
+ * */
+class StreamWritter : public json::Writter {
+public:
+    StreamWritter(std::ostream& os) : m_os(os) { }
+
+    virtual void clear() override { }
+
+    virtual void write(char ch) override { m_os.put(ch); }
+
+    virtual void write(std::size_t size, char ch) override {
+        while (size-- > 0) { m_os.put(ch); }
+    }
+
+    virtual void write(const char* str) override {
+        write(str, std::strlen(str));
+    }
+
+    virtual void write(const char* str, std::size_t length) override {
+        m_os.write(str, std::streamsize(length));
+    }
+
+    virtual void write(const std::string& str) override {
+        write(str.data(), str.size());
+    }
+
+    virtual ~StreamWritter();
+private:
+    std::ostream& m_os;
+};
+
+StreamWritter::~StreamWritter() { }
+
+}
+
 Serializer::Serializer(Formatter* formatter) :
     m_formatter(formatter),
-    m_serialized()
+    m_serialized(),
+    m_exact_size{false}
 { }
 
 Serializer::~Serializer() { }
@@ -67,8 +112,31 @@ void Serializer::write(const Value& value) {
         formatter = &default_formatter;
     }
 
+    if (m_exact_size) {
+        writter::Counter counter;
+
+        formatter->set_writter(&counter);
+        formatter->formatting(value);
+        string.reserve(counter.read());
+    }
+
     formatter->set_writter(&string);
     formatter->formatting(value);
 
     m_serialized = std::move(string.read());
 }
+
+void Serializer::write(const Value& value, Writter& writter) {
+    formatter::Compact default_formatter;
+    Formatter* formatter = (nullptr != m_formatter) ?
+        m_formatter : &default_formatter;
+
+    formatter->set_writter(&writter);
+    formatter->formatting(value);
+    writter.flush();
+}
+
+void Serializer::write(const Value& value, std::ostream& os) {
+    StreamWritter writter(os);
+    write(value, writter);
+}
@@ -0,0 +1,737 @@
+/*!
+ * @copyright
+ * Copyright (c) 2015, Tymoteusz Blazejczyk
+ *
+ * @copyright
+ * All rights reserved.
+ *
+ * @copyright
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * @copyright
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * @copyright
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * @copyright
+ * * Neither the name of json-cxx nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * @copyright
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file simd.cpp
+ *
+ * @brief JSON SIMD scanning implementation
+ * */
+
+#include "simd.hpp"
+
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define JSON_CXX_SIMD_X86
+#include <immintrin.h>
+#endif
+
+/*! Characters below are control characters and must be escaped */
+static constexpr unsigned char CONTROL_END = 0x20;
+
+/*! Characters from here are outside of ASCII */
+static constexpr unsigned char ASCII_END = 0x80;
+
+/*! Characters classified at once by structural indexing */
+static constexpr std::size_t BLOCK_SIZE = 64;
+
+/*! Character classes of single block, one bit per character */
+struct Block {
+    std::uint64_t quote;
+    std::uint64_t backslash;
+    /*! Structural characters without quote: { } [ ] , : */
+    std::uint64_t op;
+    std::uint64_t whitespace;
+};
+
+using Scanner = const char* (*)(const char*, const char*);
+using Classifier = void (*)(const char*, Block&);
+
+/*! Scanning kernels selected for the running CPU */
+struct Kernels {
+    Scanner skip_whitespaces;
+    Scanner find_structural;
+    Scanner find_string_special;
+    Scanner find_string_special_ascii;
+    Scanner find_non_ascii;
+    Classifier classify;
+};
+
+static inline
+bool is_whitespace(char ch) {
+    return (' ' == ch) || ('\n' == ch) || ('\r' == ch) || ('\t' == ch);
+}
+
+static inline
+bool is_structural(char ch) {
+    bool result;
+
+    switch (ch) {
+    case '{':
+    case '}':
+    case '[':
+    case ']':
+    case ',':
+    case ':':
+    case '"':
+        result = true;
+        break;
+    default:
+        result = false;
+        break;
+    }
+
+    return result;
+}
+
+static inline
+bool is_string_special(char ch) {
+    return ('"' == ch) || ('\\' == ch)
+        || (static_cast<unsigned char>(ch) < CONTROL_END);
+}
+
+static const char* skip_whitespaces_scalar(const char* pos, const char* end) {
+    while ((pos < end) && is_whitespace(*pos)) { ++pos; }
+    return pos;
+}
+
+static const char* find_structural_scalar(const char* pos, const char* end) {
+    while ((pos < end) && !is_structural(*pos)) { ++pos; }
+    return pos;
+}
+
+static const char* find_string_special_scalar(const char* pos,
+        const char* end) {
+    while ((pos < end) && !is_string_special(*pos)) { ++pos; }
+    return pos;
+}
+
+static const char* find_string_special_ascii_scalar(const char* pos,
+        const char* end) {
+    while ((pos < end) && !is_string_special(*pos)
+            && (static_cast<unsigned char>(*pos) < ASCII_END)) { ++pos; }
+    return pos;
+}
+
+static const char* find_non_ascii_scalar(const char* pos, const char* end) {
+    while ((pos < end) && (static_cast<unsigned char>(*pos) < ASCII_END)) {
+        ++pos;
+    }
+    return pos;
+}
+
+static void classify_scalar(const char* pos, Block& block) {
+    block = Block{0, 0, 0, 0};
+
+    for (std::size_t i = 0; i < BLOCK_SIZE; ++i) {
+        const std::uint64_t bit = std::uint64_t(1) << i;
+        const char ch = pos[i];
+
+        if ('"' == ch) {
+            block.quote |= bit;
+        }
+        else if ('\\' == ch) {
+            block.backslash |= bit;
+        }
+        else if (is_structural(ch)) {
+            block.op |= bit;
+        }
+        else if (is_whitespace(ch)) {
+            block.whitespace |= bit;
+        }
+    }
+}
+
+#if defined(JSON_CXX_SIMD_X86)
+
+/*
+ * Brackets '[' ']' differ from curly brackets '{' '}' only by 0x20 bit.
+ * Setting that bit allows to match all four of them with two comparisons
+ * */
+static constexpr char BRACKET_BIT = 0x20;
+
+__attribute__((target("sse2")))
+static const char* skip_whitespaces_sse2(const char* pos, const char* end) {
+    const __m128i space = _mm_set1_epi8(' ');
+    const __m128i newline = _mm_set1_epi8('\n');
+    const __m128i carriage = _mm_set1_epi8('\r');
+    const __m128i tab = _mm_set1_epi8('\t');
+    __m128i chunk;
+
+    while (end - pos >= std::ptrdiff_t(sizeof(chunk))) {
+        std::memcpy(&chunk, pos, sizeof(chunk));
+
+        __m128i match = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(chunk, space),
+                         _mm_cmpeq_epi8(chunk, newline)),
+            _mm_or_si128(_mm_cmpeq_epi8(chunk, carriage),
+                         _mm_cmpeq_epi8(chunk, tab)));
+
+        unsigned mask = 0xFFFFu & ~unsigned(_mm_movemask_epi8(match));
+        if (0 != mask) { return pos + __builtin_ctz(mask); }
+
+        pos += sizeof(chunk);
+    }
+
+    return skip_whitespaces_scalar(pos, end);
+}
+
+__attribute__((target("avx2")))
+static const char* skip_whitespaces_avx2(const char* pos, const char* end) {
+    const __m256i space = _mm256_set1_epi8(' ');
+    const __m256i newline = _mm256_set1_epi8('\n');
+    const __m256i carriage = _mm256_set1_epi8('\r');
+    const __m256i tab = _mm256_set1_epi8('\t');
+    __m256i chunk;
+
+    while (end - pos >= std::ptrdiff_t(sizeof(chunk))) {
+        std::memcpy(&chunk, pos, sizeof(chunk));
+
+        __m256i match = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(chunk, space),
+                            _mm256_cmpeq_epi8(chunk, newline)),
+            _mm256_or_si256(_mm256_cmpeq_epi8(chunk, carriage),
+                            _mm256_cmpeq_epi8(chunk, tab)));
+
+        unsigned mask = ~unsigned(_mm256_movemask_epi8(match));
+        if (0 != mask) { return pos + __builtin_ctz(mask); }
+
+        pos += sizeof(chunk);
+    }
+
+    return skip_whitespaces_sse2(pos, end);
+}
+
+__attribute__((target("sse2")))
+static const char* find_structural_sse2(const char* pos, const char* end) {
+    const __m128i bracket_bit = _mm_set1_epi8(BRACKET_BIT);
+    const __m128i curly_open = _mm_set1_epi8('{');
+    const __m128i curly_close = _mm_set1_epi8('}');
+    const __m128i comma = _mm_set1_epi8(',');
+    const __m128i colon = _mm_set1_epi8(':');
+    const __m128i quote = _mm_set1_epi8('"');
+    __m128i chunk;
+
+    while (end - pos >= std::ptrdiff_t(sizeof(chunk))) {
+        std::memcpy(&chunk, pos, sizeof(chunk));
+
+        __m128i brackets = _mm_or_si128(chunk, bracket_bit);
+        __m128i match = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(brackets, curly_open),
+                         _mm_cmpeq_epi8(brackets, curly_close)),
+            _mm_or_si128(
+                _mm_or_si128(_mm_cmpeq_epi8(chunk, comma),
+                             _mm_cmpeq_epi8(chunk, colon)),
+                _mm_cmpeq_epi8(chunk, quote)));
+
+        unsigned mask = unsigned(_mm_movemask_epi8(match));
+        if (0 != mask) { return pos + __builtin_ctz(mask); }
+
+        pos += sizeof(chunk);
+    }
+
+    return find_structural_scalar(pos, end);
+}
+
+__attribute__((target("avx2")))
+static const char* find_structural_avx2(const char* pos, const char* end) {
+    const __m256i bracket_bit = _mm256_set1_epi8(BRACKET_BIT);
+    const __m256i curly_open = _mm256_set1_epi8('{');
+    const __m256i curly_close = _mm256_set1_epi8('}');
+    const __m256i comma = _mm256_set1_epi8(',');
+    const __m256i colon = _mm256_set1_epi8(':');
+    const __m256i quote = _mm256_set1_epi8('"');
+    __m256i chunk;
+
+    while (end - pos >= std::ptrdiff_t(sizeof(chunk))) {
+        std::memcpy(&chunk, pos, sizeof(chunk));
+
+        __m256i brackets = _mm256_or_si256(chunk, bracket_bit);
+        __m256i match = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(brackets, curly_open),
+                            _mm256_cmpeq_epi8(brackets, curly_close)),
+            _mm256_or_si256(
+                _mm256_or_si256(_mm256_cmpeq_epi8(chunk, comma),
+                                _mm256_cmpeq_epi8(chunk, colon)),
+                _mm256_cmpeq_epi8(chunk, quote)));
+
+        unsigned mask = unsigned(_mm256_movemask_epi8(match));
+        if (0 != mask) { return pos + __builtin_ctz(mask); }
+
+        pos += sizeof(chunk);
+    }
+
+    return find_structural_sse2(pos, end);
+}
+
+/*
+ * Unsigned comparison ch <= 0x1F is done as min(ch, 0x1F) == ch because
+ * SSE2 and AVX2 have only signed bytes comparisons
+ * */
+__attribute__((target("sse2")))
+static const char* find_string_special_sse2(const char* pos,
+        const char* end) {
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i control = _mm_set1_epi8(CONTROL_END - 1);
+    __m128i chunk;
+
+    while (end - pos >= std::ptrdiff_t(sizeof(chunk))) {
+        std::memcpy(&chunk, pos, sizeof(chunk));
+
+        __m128i match = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(chunk, quote),
+                         _mm_cmpeq_epi8(chunk, backslash)),
+            _mm_cmpeq_epi8(_mm_min_epu8(chunk, control), chunk));
+
+        unsigned mask = unsigned(_mm_movemask_epi8(match));
+        if (0 != mask) { return pos + __builtin_ctz(mask); }
+
+        pos += sizeof(chunk);
+    }
+
+    return find_string_special_scalar(pos, end);
+}
+
+__attribute__((target("avx2")))
+static const char* find_string_special_avx2(const char* pos,
+        const char* end) {
+    const __m256i quote = _mm256_set1_epi8('"');
+    const __m256i backslash = _mm256_set1_epi8('\\');
+    const __m256i control = _mm256_set1_epi8(CONTROL_END - 1);
+    __m256i chunk;
+
+    while (end - pos >= std::ptrdiff_t(sizeof(chunk))) {
+        std::memcpy(&chunk, pos, sizeof(chunk));
+
+        __m256i match = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(chunk, quote),
+                            _mm256_cmpeq_epi8(chunk, backslash)),
+            _mm256_cmpeq_epi8(_mm256_min_epu8(chunk, control), chunk));
+
+        unsigned mask = unsigned(_mm256_movemask_epi8(match));
+        if (0 != mask) { return pos + __builtin_ctz(mask); }
+
+        pos += sizeof(chunk);
+    }
+
+    return find_string_special_sse2(pos, end);
+}
+
+/*
+ * As signed bytes, characters above 0x7F are negative, so single signed
+ * comparison ch < 0x20 matches both control and non-ASCII characters
+ * */
+__attribute__((target("sse2")))
+static const char* find_string_special_ascii_sse2(const char* pos,
+        const char* end) {
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i control = _mm_set1_epi8(CONTROL_END);
+    __m128i chunk;
+
+    while (end - pos >= std::ptrdiff_t(sizeof(chunk))) {
+        std::memcpy(&chunk, pos, sizeof(chunk));
+
+        __m128i match = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(chunk, quote),
+                         _mm_cmpeq_epi8(chunk, backslash)),
+            _mm_cmplt_epi8(chunk, control));
+
+        unsigned mask = unsigned(_mm_movemask_epi8(match));
+        if (0 != mask) { return pos + __builtin_ctz(mask); }
+
+        pos += sizeof(chunk);
+    }
+
+    return find_string_special_ascii_scalar(pos, end);
+}
+
+__attribute__((target("avx2")))
+static const char* find_string_special_ascii_avx2(const char* pos,
+        const char* end) {
+    const __m256i quote = _mm256_set1_epi8('"');
+    const __m256i backslash = _mm256_set1_epi8('\\');
+    const __m256i control = _mm256_set1_epi8(CONTROL_END);
+    __m256i chunk;
+
+    while (end - pos >= std::ptrdiff_t(sizeof(chunk))) {
+        std::memcpy(&chunk, pos, sizeof(chunk));
+
+        __m256i match = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(chunk, quote),
+                            _mm256_cmpeq_epi8(chunk, backslash)),
+            _mm256_cmpgt_epi8(control, chunk));
+
+        unsigned mask = unsigned(_mm256_movemask_epi8(match));
+        if (0 != mask) { return pos + __builtin_ctz(mask); }
+
+        pos += sizeof(chunk);
+    }
+
+    return find_string_special_ascii_sse2(pos, end);
+}
+
+/*
+ * Characters above 0x7F have the highest bit set, byte mask is taken
+ * directly from the loaded chunk
+ * */
+__attribute__((target("sse2")))
+static const char* find_non_ascii_sse2(const char* pos, const char* end) {
+    __m128i chunk;
+
+    while (end - pos >= std::ptrdiff_t(sizeof(chunk))) {
+        std::memcpy(&chunk, pos, sizeof(chunk));
+
+        unsigned mask = unsigned(_mm_movemask_epi8(chunk));
+        if (0 != mask) { return pos + __builtin_ctz(mask); }
+
+        pos += sizeof(chunk);
+    }
+
+    return find_non_ascii_scalar(pos, end);
+}
+
+__attribute__((target("avx2")))
+static const char* find_non_ascii_avx2(const char* pos, const char* end) {
+    __m256i chunk;
+
+    while (end - pos >= std::ptrdiff_t(sizeof(chunk))) {
+        std::memcpy(&chunk, pos, sizeof(chunk));
+
+        unsigned mask = unsigned(_mm256_movemask_epi8(chunk));
+        if (0 != mask) { return pos + __builtin_ctz(mask); }
+
+        pos += sizeof(chunk);
+    }
+
+    return find_non_ascii_sse2(pos, end);
+}
+
+__attribute__((target("sse2")))
+static void classify_sse2(const char* pos, Block& block) {
+    const __m128i bracket_bit = _mm_set1_epi8(BRACKET_BIT);
+    const __m128i curly_open = _mm_set1_epi8('{');
+    const __m128i curly_close = _mm_set1_epi8('}');
+    const __m128i comma = _mm_set1_epi8(',');
+    const __m128i colon = _mm_set1_epi8(':');
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i space = _mm_set1_epi8(' ');
+    const __m128i newline = _mm_set1_epi8('\n');
+    const __m128i carriage = _mm_set1_epi8('\r');
+    const __m128i tab = _mm_set1_epi8('\t');
+    __m128i chunk;
+
+    block = Block{0, 0, 0, 0};
+
+    for (std::size_t i = 0; i < BLOCK_SIZE; i += sizeof(chunk)) {
+        std::memcpy(&chunk, pos + i, sizeof(chunk));
+
+        __m128i brackets = _mm_or_si128(chunk, bracket_bit);
+        __m128i op = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(brackets, curly_open),
+                         _mm_cmpeq_epi8(brackets, curly_close)),
+            _mm_or_si128(_mm_cmpeq_epi8(chunk, comma),
+                         _mm_cmpeq_epi8(chunk, colon)));
+        __m128i whitespace = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(chunk, space),
+                         _mm_cmpeq_epi8(chunk, newline)),
+            _mm_or_si128(_mm_cmpeq_epi8(chunk, carriage),
+                         _mm_cmpeq_epi8(chunk, tab)));
+
+        block.quote |= std::uint64_t(unsigned(_mm_movemask_epi8(
+                        _mm_cmpeq_epi8(chunk, quote)))) << i;
+        block.backslash |= std::uint64_t(unsigned(_mm_movemask_epi8(
+                        _mm_cmpeq_epi8(chunk, backslash)))) << i;
+        block.op |= std::uint64_t(unsigned(_mm_movemask_epi8(op))) << i;
+        block.whitespace |=
+            std::uint64_t(unsigned(_mm_movemask_epi8(whitespace))) << i;
+    }
+}
+
+__attribute__((target("avx2")))
+static void classify_avx2(const char* pos, Block& block) {
+    const __m256i bracket_bit = _mm256_set1_epi8(BRACKET_BIT);
+    const __m256i curly_open = _mm256_set1_epi8('{');
+    const __m256i curly_close = _mm256_set1_epi8('}');
+    const __m256i comma = _mm256_set1_epi8(',');
+    const __m256i colon = _mm256_set1_epi8(':');
+    const __m256i quote = _mm256_set1_epi8('"');
+    const __m256i backslash = _mm256_set1_epi8('\\');
+    const __m256i space = _mm256_set1_epi8(' ');
+    const __m256i newline = _mm256_set1_epi8('\n');
+    const __m256i carriage = _mm256_set1_epi8('\r');
+    const __m256i tab = _mm256_set1_epi8('\t');
+    __m256i chunk;
+
+    block = Block{0, 0, 0, 0};
+
+    for (std::size_t i = 0; i < BLOCK_SIZE; i += sizeof(chunk)) {
+        std::memcpy(&chunk, pos + i, sizeof(chunk));
+
+        __m256i brackets = _mm256_or_si256(chunk, bracket_bit);
+        __m256i op = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(brackets, curly_open),
+                            _mm256_cmpeq_epi8(brackets, curly_close)),
+            _mm256_or_si256(_mm256_cmpeq_epi8(chunk, comma),
+                            _mm256_cmpeq_epi8(chunk, colon)));
+        __m256i whitespace = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(chunk, space),
+                            _mm256_cmpeq_epi8(chunk, newline)),
+            _mm256_or_si256(_mm256_cmpeq_epi8(chunk, carriage),
+                            _mm256_cmpeq_epi8(chunk, tab)));
+
+        block.quote |= std::uint64_t(unsigned(_mm256_movemask_epi8(
+                        _mm256_cmpeq_epi8(chunk, quote)))) << i;
+        block.backslash |= std::uint64_t(unsigned(_mm256_movemask_epi8(
+                        _mm256_cmpeq_epi8(chunk, backslash)))) << i;
+        block.op |= std::uint64_t(unsigned(_mm256_movemask_epi8(op))) << i;
+        block.whitespace |=
+            std::uint64_t(unsigned(_mm256_movemask_epi8(whitespace))) << i;
+    }
+}
+
+#endif /* JSON_CXX_SIMD_X86 */
+
+static Kernels select_kernels() {
+    Kernels kernels{
+        skip_whitespaces_scalar,
+        find_structural_scalar,
+        find_string_special_scalar,
+        find_string_special_ascii_scalar,
+        find_non_ascii_scalar,
+        classify_scalar
+    };
+
+#if defined(JSON_CXX_SIMD_X86)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        kernels = {
+            skip_whitespaces_avx2,
+            find_structural_avx2,
+            find_string_special_avx2,
+            find_string_special_ascii_avx2,
+            find_non_ascii_avx2,
+            classify_avx2
+        };
+    }
+    else if (__builtin_cpu_supports("sse2")) {
+        kernels = {
+            skip_whitespaces_sse2,
+            find_structural_sse2,
+            find_string_special_sse2,
+            find_string_special_ascii_sse2,
+            find_non_ascii_sse2,
+            classify_sse2
+        };
+    }
+#endif
+
+    return kernels;
+}
+
+static const Kernels& get_kernels() {
+    static const Kernels kernels = select_kernels();
+    return kernels;
+}
+
+const char* json::simd::skip_whitespaces(const char* pos, const char* end) {
+    /* Most of tokens are separated by none or a single whitespace */
+    if ((pos >= end) || !is_whitespace(*pos)) { return pos; }
+    if ((++pos >= end) || !is_whitespace(*pos)) { return pos; }
+
+    return get_kernels().skip_whitespaces(pos, end);
+}
+
+const char* json::simd::find_structural(const char* pos, const char* end) {
+    return get_kernels().find_structural(pos, end);
+}
+
+const char* json::simd::find_string_special(const char* pos,
+        const char* end) {
+    return get_kernels().find_string_special(pos, end);
+}
+
+const char* json::simd::find_string_special_ascii(const char* pos,
+        const char* end) {
+    return get_kernels().find_string_special_ascii(pos, end);
+}
+
+/*!
+ * @brief Read single multibyte UTF-8 sequence
+ *
+ * @param[in]   pos     Lead byte above 0x7F
+ * @param[in]   end     End of characters array
+ *
+ * @return  Pointer after valid sequence, nullptr when it is invalid
+ * */
+static const char* read_utf8(const char* pos, const char* end) {
+    const auto lead = static_cast<unsigned char>(*pos);
+    /* Range of the first continuation byte excludes overlong encodings,
+     * surrogates and code points above U+10FFFF */
+    unsigned char low = 0x80;
+    unsigned char high = 0xBF;
+    std::ptrdiff_t length;
+
+    if ((lead >= 0xC2) && (lead <= 0xDF)) {
+        length = 2;
+    }
+    else if ((lead >= 0xE0) && (lead <= 0xEF)) {
+        if (0xE0 == lead) { low = 0xA0; }
+        if (0xED == lead) { high = 0x9F; }
+        length = 3;
+    }
+    else if ((lead >= 0xF0) && (lead <= 0xF4)) {
+        if (0xF0 == lead) { low = 0x90; }
+        if (0xF4 == lead) { high = 0x8F; }
+        length = 4;
+    }
+    else {
+        return nullptr;
+    }
+
+    if ((end - pos) < length) { return nullptr; }
+
+    auto ch = static_cast<unsigned char>(pos[1]);
+    if ((ch < low) || (ch > high)) { return nullptr; }
+
+    for (std::ptrdiff_t i = 2; i < length; ++i) {
+        ch = static_cast<unsigned char>(pos[i]);
+        if ((ch < 0x80) || (ch > 0xBF)) { return nullptr; }
+    }
+
+    return pos + length;
+}
+
+/*
+ * JSON texts are mostly ASCII, only multibyte sequences are visited
+ * one by one
+ * */
+const char* json::simd::validate_utf8(const char* pos, const char* end) {
+    const Kernels& kernels = get_kernels();
+
+    pos = kernels.find_non_ascii(pos, end);
+    while (pos < end) {
+        const char* next = read_utf8(pos, end);
+        if (nullptr == next) { return pos; }
+        pos = kernels.find_non_ascii(next, end);
+    }
+
+    return end;
+}
+
+/*!
+ * @brief Mark characters escaped by backslashes
+ *
+ * Backslashes are rare, so they are visited one by one
+ *
+ * @param[in]       backslash   Backslashes in block
+ * @param[in,out]   carry       First character of block is escaped
+ *
+ * @return  Escaped characters
+ * */
+static inline
+std::uint64_t find_escaped(std::uint64_t backslash, std::uint64_t& carry) {
+    std::uint64_t escaped = carry;
+
+    backslash &= ~carry;
+    carry = 0;
+
+    while (0 != backslash) {
+        const unsigned i = unsigned(__builtin_ctzll(backslash));
+
+        if ((BLOCK_SIZE - 1) == i) {
+            carry = 1;
+            break;
+        }
+
+        escaped |= std::uint64_t(1) << (i + 1);
+        backslash &= ~(std::uint64_t(3) << i);
+    }
+
+    return escaped;
+}
+
+/*!
+ * @brief Prefix XOR, bit is set when odd number of bits is set up to it
+ * */
+static inline
+std::uint64_t prefix_xor(std::uint64_t bits) {
+    bits ^= bits << 1;
+    bits ^= bits << 2;
+    bits ^= bits << 4;
+    bits ^= bits << 8;
+    bits ^= bits << 16;
+    bits ^= bits << 32;
+    return bits;
+}
+
+void json::simd::index_structurals(const char* begin, const char* end,
+        std::vector<std::uint32_t>& index) {
+    const Classifier classify = get_kernels().classify;
+    const std::size_t length = std::size_t(end - begin);
+    std::uint64_t escaped_carry = 0;
+    /* All ones when previous block ends inside string */
+    std::uint64_t string_carry = 0;
+    /* Last character of previous block is part of scalar */
+    std::uint64_t scalar_carry = 0;
+    char tail[BLOCK_SIZE];
+    Block block;
+
+    index.clear();
+    index.reserve(length / 4);
+
+    for (std::size_t offset = 0; offset < length; offset += BLOCK_SIZE) {
+        if ((length - offset) >= BLOCK_SIZE) {
+            classify(begin + offset, block);
+        }
+        else {
+            /* Last block is padded with spaces */
+            std::memset(tail, ' ', sizeof(tail));
+            std::memcpy(tail, begin + offset, length - offset);
+            classify(tail, block);
+        }
+
+        const std::uint64_t quote = block.quote
+            & ~find_escaped(block.backslash, escaped_carry);
+        const std::uint64_t in_string = prefix_xor(quote) ^ string_carry;
+        const std::uint64_t scalar = ~(block.op | block.whitespace | quote)
+            & ~in_string;
+        std::uint64_t bits = (block.op & ~in_string) | (quote & in_string)
+            | (scalar & ~((scalar << 1) | scalar_carry));
+
+        string_carry = 0 - (in_string >> 63);
+        scalar_carry = scalar >> 63;
+
+        while (0 != bits) {
+            index.push_back(std::uint32_t(offset)
+                    + std::uint32_t(__builtin_ctzll(bits)));
+            bits &= bits - 1;
+        }
+    }
+}
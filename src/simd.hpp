@@ -0,0 +1,130 @@
+/*!
+ * @copyright
+ * Copyright (c) 2015, Tymoteusz Blazejczyk
+ *
+ * @copyright
+ * All rights reserved.
+ *
+ * @copyright
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * @copyright
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * @copyright
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * @copyright
+ * * Neither the name of json-cxx nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * @copyright
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file simd.hpp
+ *
+ * @brief JSON SIMD scanning interface
+ *
+ * Vectorized kernels are selected once at runtime based on CPU features.
+ * When no SIMD instruction set is available, scalar fallbacks are used
+ * */
+
+#ifndef JSON_CXX_SIMD_HPP
+#define JSON_CXX_SIMD_HPP
+
+#include <vector>
+#include <cstdint>
+
+namespace json {
+namespace simd {
+
+/*!
+ * @brief Skip JSON whitespaces: space, tabulation, newline, carriage return
+ *
+ * @param[in]   pos     Begin of characters array
+ * @param[in]   end     End of characters array
+ *
+ * @return  Pointer to the first non-whitespace character or end
+ * */
+const char* skip_whitespaces(const char* pos, const char* end);
+
+/*!
+ * @brief Find next JSON structural character: { } [ ] , : "
+ *
+ * @param[in]   pos     Begin of characters array
+ * @param[in]   end     End of characters array
+ *
+ * @return  Pointer to the first structural character or end
+ * */
+const char* find_structural(const char* pos, const char* end);
+
+/*!
+ * @brief Find next JSON string character that cannot be copied as it is:
+ * quote ", backslash \\ or control character below 0x20
+ *
+ * @param[in]   pos     Begin of characters array
+ * @param[in]   end     End of characters array
+ *
+ * @return  Pointer to the first special character or end
+ * */
+const char* find_string_special(const char* pos, const char* end);
+
+/*!
+ * @brief Find next JSON string character that cannot be written as it is to
+ * ASCII only output: quote ", backslash \\, control character below 0x20
+ * or any character above 0x7F
+ *
+ * @param[in]   pos     Begin of characters array
+ * @param[in]   end     End of characters array
+ *
+ * @return  Pointer to the first special character or end
+ * */
+const char* find_string_special_ascii(const char* pos, const char* end);
+
+/*!
+ * @brief Validate UTF-8 encoding
+ *
+ * Overlong encodings, UTF-16 surrogates, code points above U+10FFFF and
+ * truncated sequences are invalid. ASCII runs are skipped with SIMD
+ *
+ * @param[in]   pos     Begin of characters array
+ * @param[in]   end     End of characters array
+ *
+ * @return  Pointer to the first invalid sequence or end
+ * */
+const char* validate_utf8(const char* pos, const char* end);
+
+/*!
+ * @brief Build structural index of JSON text
+ *
+ * Input is classified in 64 characters blocks. Index gets offsets, in
+ * order, of structural characters { } [ ] , : outside of strings, opening
+ * quotes of strings and first characters of other scalars. Escaped quotes
+ * don't change strings bounds
+ *
+ * @param[in]   begin   Begin of JSON text, at most 4 GiB long
+ * @param[in]   end     End of JSON text
+ * @param[out]  index   Offsets from begin of indexed characters
+ * */
+void index_structurals(const char* begin, const char* end,
+        std::vector<std::uint32_t>& index);
+
+}
+}
+
+#endif /* JSON_CXX_SIMD_HPP */
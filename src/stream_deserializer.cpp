@@ -0,0 +1,89 @@
+/*!
+ * @copyright
+ * Copyright (c) 2015, Tymoteusz Blazejczyk
+ *
+ * @copyright
+ * All rights reserved.
+ *
+ * @copyright
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * @copyright
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * @copyright
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * @copyright
+ * * Neither the name of json-cxx nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * @copyright
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file stream_deserializer.cpp
+ *
+ * @brief JSON incremental deserializer implementation
+ * */
+
+#include "json/stream_deserializer.hpp"
+#include "parser.hpp"
+
+#include "json/handler.hpp"
+
+using json::Parser;
+using json::StreamDeserializer;
+
+StreamDeserializer::StreamDeserializer() { }
+
+StreamDeserializer::StreamDeserializer(Handler& handler) :
+    m_handler{&handler} { }
+
+StreamDeserializer::~StreamDeserializer() { }
+
+bool StreamDeserializer::parsing(const char* str, std::size_t length) {
+    return parsing(str, length, false);
+}
+
+void StreamDeserializer::finish() {
+    if (!m_complete) {
+        parsing(nullptr, 0, true);
+    }
+}
+
+void StreamDeserializer::clear() {
+    m_parser.reset();
+    m_value = nullptr;
+    m_complete = false;
+}
+
+bool StreamDeserializer::parsing(const char* str, std::size_t length,
+        bool last) {
+    if (nullptr == m_parser) {
+        m_parser.reset(new Parser(nullptr, 0, m_limit));
+    }
+
+    if (nullptr != m_handler) {
+        m_complete = m_parser->parsing(str, length, last, *m_handler);
+    }
+    else {
+        m_complete = m_parser->parsing(str, length, last, m_value);
+    }
+
+    return m_complete;
+}
@@ -0,0 +1,326 @@
+/*!
+ * @copyright
+ * Copyright (c) 2015, Tymoteusz Blazejczyk
+ *
+ * @copyright
+ * All rights reserved.
+ *
+ * @copyright
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * @copyright
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * @copyright
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * @copyright
+ * * Neither the name of json-cxx nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * @copyright
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file tape.cpp
+ *
+ * @brief JSON tape implementation
+ * */
+
+#include "json/tape.hpp"
+#include "json/value_error.hpp"
+
+#include "parser.hpp"
+
+using json::Value;
+using json::Parser;
+using json::Tape;
+using json::TapeView;
+using json::ValueError;
+
+const std::size_t Tape::DEFAULT_LIMIT_PER_OBJECT;
+constexpr unsigned Tape::TAG_SHIFT;
+constexpr unsigned Tape::COUNT_SHIFT;
+constexpr std::uint64_t Tape::INDEX_MASK;
+constexpr std::uint64_t Tape::COUNT_MAX;
+
+std::uint64_t TapeView::word() const {
+    return m_tape->m_words[m_index];
+}
+
+TapeView::Type TapeView::get_type() const {
+    if (nullptr == m_tape) { return Type::NIL; }
+
+    Type type;
+
+    switch (Tape::get_tag(word())) {
+    case Tape::TAG_STRING:
+        type = Type::STRING;
+        break;
+    case Tape::TAG_OBJECT:
+        type = Type::OBJECT;
+        break;
+    case Tape::TAG_ARRAY:
+        type = Type::ARRAY;
+        break;
+    case Tape::TAG_TRUE:
+    case Tape::TAG_FALSE:
+        type = Type::BOOLEAN;
+        break;
+    case Tape::TAG_INT:
+    case Tape::TAG_UINT:
+    case Tape::TAG_DOUBLE:
+        type = Type::NUMBER;
+        break;
+    case Tape::TAG_NULL:
+    case Tape::TAG_ARRAY_END:
+    case Tape::TAG_OBJECT_END:
+    default:
+        type = Type::NIL;
+        break;
+    }
+
+    return type;
+}
+
+std::size_t TapeView::next(std::size_t index) const {
+    const std::uint64_t value = m_tape->m_words[index];
+    std::size_t result;
+
+    switch (Tape::get_tag(value)) {
+    case Tape::TAG_OBJECT:
+    case Tape::TAG_ARRAY:
+        result = value & Tape::INDEX_MASK;
+        break;
+    case Tape::TAG_INT:
+    case Tape::TAG_UINT:
+    case Tape::TAG_DOUBLE:
+        result = index + 2;
+        break;
+    case Tape::TAG_NULL:
+    case Tape::TAG_TRUE:
+    case Tape::TAG_FALSE:
+    case Tape::TAG_STRING:
+    case Tape::TAG_ARRAY_END:
+    case Tape::TAG_OBJECT_END:
+    default:
+        result = index + 1;
+        break;
+    }
+
+    return result;
+}
+
+std::size_t TapeView::size() const {
+    if (!is_object() && !is_array()) { return 0; }
+
+    std::size_t count = (word() >> Tape::COUNT_SHIFT) & Tape::COUNT_MAX;
+
+    /* Elements count saturated, count them */
+    if (Tape::COUNT_MAX == count) {
+        count = 0;
+        for (auto it = begin(); it != end(); ++it) { ++count; }
+    }
+
+    return count;
+}
+
+TapeView::Iterator TapeView::begin() const {
+    if (!is_object() && !is_array()) { return end(); }
+    return Iterator(*this, m_index + 1, is_object());
+}
+
+TapeView::Iterator TapeView::end() const {
+    const bool container = is_object() || is_array();
+    std::size_t index = m_index;
+
+    if (container) {
+        index = (word() & Tape::INDEX_MASK) - 1;
+    }
+
+    return Iterator(*this, index, is_object());
+}
+
+TapeView TapeView::operator[](std::size_t index) const {
+    for (auto it = begin(); it != end(); ++it) {
+        if (0 == index--) { return *it; }
+    }
+
+    return TapeView();
+}
+
+TapeView TapeView::find(const char* key, std::size_t length) const {
+    if (!is_object()) { return TapeView(); }
+
+    for (auto it = begin(); it != end(); ++it) {
+        const TapeView name(m_tape, it.m_index);
+
+        if ((name.length() == length)
+                && (0 == std::memcmp(name.as_char(), key, length))) {
+            return *it;
+        }
+    }
+
+    return TapeView();
+}
+
+std::size_t TapeView::length() const {
+    if (!is_string()) {
+        throw ValueError(ValueError::NOT_STRING);
+    }
+
+    std::uint32_t size;
+    std::memcpy(&size, &m_tape->m_strings[word()
+                & ((std::uint64_t(1) << Tape::TAG_SHIFT) - 1)],
+            sizeof(size));
+
+    return size;
+}
+
+const char* TapeView::as_char() const {
+    if (!is_string()) {
+        throw ValueError(ValueError::NOT_STRING);
+    }
+
+    return m_tape->m_strings.data() + (word()
+            & ((std::uint64_t(1) << Tape::TAG_SHIFT) - 1))
+        + sizeof(std::uint32_t);
+}
+
+json::String TapeView::as_string() const {
+    return String(as_char(), length());
+}
+
+json::Bool TapeView::as_bool() const {
+    if (!is_boolean()) {
+        throw ValueError(ValueError::NOT_BOOLEAN);
+    }
+
+    return Tape::TAG_TRUE == Tape::get_tag(word());
+}
+
+json::Number TapeView::as_number() const {
+    if (!is_number()) {
+        throw ValueError(ValueError::NOT_NUMBER);
+    }
+
+    const std::uint64_t bits = m_tape->m_words[m_index + 1];
+    Number number;
+
+    switch (Tape::get_tag(word())) {
+    case Tape::TAG_INT:
+        number.m_type = Number::Type::INT;
+        number.m_int = Int64(bits);
+        break;
+    case Tape::TAG_UINT:
+        number.m_type = Number::Type::UINT;
+        number.m_uint = bits;
+        break;
+    case Tape::TAG_DOUBLE:
+    case Tape::TAG_NULL:
+    case Tape::TAG_TRUE:
+    case Tape::TAG_FALSE:
+    case Tape::TAG_STRING:
+    case Tape::TAG_ARRAY:
+    case Tape::TAG_ARRAY_END:
+    case Tape::TAG_OBJECT:
+    case Tape::TAG_OBJECT_END:
+    default:
+        number.m_type = Number::Type::DOUBLE;
+        std::memcpy(&number.m_double, &bits, sizeof(bits));
+        break;
+    }
+
+    return number;
+}
+
+Value TapeView::to_value() const {
+    Value value;
+
+    switch (get_type()) {
+    case Type::OBJECT:
+        value = Value::Type::OBJECT;
+        for (auto it = begin(); it != end(); ++it) {
+            value.append(TapeView(m_tape, it.m_index).as_string(),
+                    (*it).to_value());
+        }
+        break;
+    case Type::ARRAY:
+        value = Value::Type::ARRAY;
+        for (auto it = begin(); it != end(); ++it) {
+            value.push_back((*it).to_value());
+        }
+        break;
+    case Type::STRING:
+        value = as_string();
+        break;
+    case Type::NUMBER:
+        value = as_number();
+        break;
+    case Type::BOOLEAN:
+        value = as_bool();
+        break;
+    case Type::NIL:
+    default:
+        break;
+    }
+
+    return value;
+}
+
+TapeView TapeView::Iterator::operator*() const {
+    return TapeView(m_view.m_tape, m_index + (m_object ? 1 : 0));
+}
+
+const char* TapeView::Iterator::key() const {
+    if (!m_object) { return ""; }
+    return TapeView(m_view.m_tape, m_index).as_char();
+}
+
+Tape::Tape() :
+    m_words{},
+    m_strings{},
+    m_limit{DEFAULT_LIMIT_PER_OBJECT},
+    m_words_limit{INDEX_MASK},
+    m_structural_index{false}
+{ }
+
+Tape::~Tape() { }
+
+TapeView Tape::get_root() const {
+    if (m_words.empty()) { return TapeView(); }
+    return TapeView(this, 0);
+}
+
+void Tape::clear() {
+    m_words.clear();
+    m_strings.clear();
+}
+
+void Tape::parsing(const char* str, std::size_t length) {
+    clear();
+
+    try {
+        Parser parser(str, length, m_limit);
+        parser.set_indexed(m_structural_index);
+        parser.parsing(*this);
+    }
+    catch (...) {
+        clear();
+        throw;
+    }
+}
@@ -46,152 +46,143 @@
 #include "json/value_error.hpp"
 
 #include <limits>
+#include <iterator>
 #include <type_traits>
 #include <functional>
 
 using json::Value;
 
-Value::Value(Type type) : m_type(type) {
-    switch (m_type) {
+static_assert(sizeof(Value) == sizeof(json::Number),
+        "JSON value must be as small as JSON number");
+
+Value::Value(Type type) {
+    switch (type) {
     case Type::OBJECT:
-        new (&m_object) Object();
+        m_storage.object = new Members();
         break;
     case Type::ARRAY:
-        new (&m_array) Array();
+        m_storage.array = new Array();
         break;
     case Type::STRING:
-        new (&m_string) String();
+        m_storage.string = new String();
         break;
     case Type::NUMBER:
         new (&m_number) Number();
-        break;
+        return;
     case Type::BOOLEAN:
-        m_boolean = false;
+        m_storage.boolean = false;
         break;
     case Type::NIL:
     default:
+        type = Type::NIL;
         break;
     }
+    m_storage.tag = Tag(TAG_NIL + unsigned(type));
 }
 
-Value::Value(Null) : m_type(Type::NIL) { }
+Value::Value(Null) {
+    m_storage.tag = TAG_NIL;
+}
 
-Value::Value(Bool boolean) : m_type(Type::BOOLEAN) {
-    m_boolean = boolean;
+Value::Value(Bool boolean) {
+    m_storage.tag = TAG_BOOLEAN;
+    m_storage.boolean = boolean;
 }
 
-Value::Value(const char* str) : m_type(Type::STRING) {
-    new (&m_string) String(str);
+Value::Value(const char* str) {
+    m_storage.string = new String(str);
+    m_storage.tag = TAG_STRING;
 }
 
-Value::Value(const String& str) : m_type(Type::STRING) {
-    new (&m_string) String(str);
+Value::Value(const String& str) {
+    m_storage.string = new String(str);
+    m_storage.tag = TAG_STRING;
 }
 
-Value::Value(const Pair& pair) : m_type(Type::OBJECT) {
-    new (&m_object) Object{pair};
+Value::Value(const Pair& pair) {
+    m_storage.object = new Members{pair};
+    m_storage.tag = TAG_OBJECT;
 }
 
-Value::Value(const char* key, const Value& value) : m_type(Type::OBJECT) {
-    new (&m_object) Object{std::make_pair(key, value)};
+Value::Value(const char* key, const Value& value) {
+    m_storage.object = new Members{std::make_pair(key, value)};
+    m_storage.tag = TAG_OBJECT;
 }
 
-Value::Value(const String& key, const Value& value) : m_type(Type::OBJECT) {
-    new (&m_object) Object{std::make_pair(key, value)};
+Value::Value(const String& key, const Value& value) {
+    m_storage.object = new Members{std::make_pair(key, value)};
+    m_storage.tag = TAG_OBJECT;
 }
 
-Value::Value(Uint value) : m_type(Type::NUMBER) {
+Value::Value(Uint value) {
     new (&m_number) Number(value);
 }
 
-Value::Value(Int value) : m_type(Type::NUMBER) {
+Value::Value(Int value) {
     new (&m_number) Number(value);
 }
 
-Value::Value(Double value) : m_type(Type::NUMBER) {
+Value::Value(Double value) {
     new (&m_number) Number(value);
 }
 
-Value::Value(const Number& number) : m_type(Type::NUMBER) {
+Value::Value(const Number& number) {
     new (&m_number) Number(number);
 }
 
-Value::Value(size_t count, const Value& value) : m_type(Type::ARRAY) {
-    new (&m_array) Array(count, value);
+Value::Value(size_t count, const Value& value) {
+    m_storage.array = new Array(count, value);
+    m_storage.tag = TAG_ARRAY;
 }
 
-Value::Value(std::initializer_list<Pair> init_list) : m_type(Type::OBJECT) {
-    new (&m_object) Object();
-
+Value::Value(std::initializer_list<Pair> init_list) : Value(Type::OBJECT) {
     for (auto it = init_list.begin(); it < init_list.end(); ++it) {
         (*this)[it->first] = it->second;
     }
 }
 
-Value::Value(std::initializer_list<Value> init_list) : m_type(Type::ARRAY) {
-    new (&m_array) Array(init_list);
+Value::Value(std::initializer_list<Value> init_list) {
+    m_storage.array = new Array(init_list);
+    m_storage.tag = TAG_ARRAY;
 }
 
-Value::Value(const Value& value) : m_type(value.m_type) {
-    switch (m_type) {
+Value::Value(const Value& value) {
+    switch (value.get_type()) {
     case Type::OBJECT:
-        new (&m_object) Object(value.m_object);
+        m_storage.object = new Members(*value.m_storage.object);
+        m_storage.tag = TAG_OBJECT;
         break;
     case Type::ARRAY:
-        new (&m_array) Array(value.m_array);
+        m_storage.array = new Array(*value.m_storage.array);
+        m_storage.tag = TAG_ARRAY;
         break;
     case Type::STRING:
-        new (&m_string) String(value.m_string);
+        m_storage.string = new String(*value.m_storage.string);
+        m_storage.tag = TAG_STRING;
         break;
     case Type::NUMBER:
         new (&m_number) Number(value.m_number);
         break;
     case Type::BOOLEAN:
-        m_boolean = value.m_boolean;
-        break;
     case Type::NIL:
     default:
+        m_storage = value.m_storage;
         break;
     }
 }
 
-Value::Value(Value&& value) : m_type(value.m_type) {
-    switch (m_type) {
+void Value::destroy() {
+    switch (get_type()) {
     case Type::OBJECT:
-        new (&m_object) Object(std::move(value.m_object));
+        delete m_storage.object;
         break;
     case Type::ARRAY:
-        new (&m_array) Array(std::move(value.m_array));
+        delete m_storage.array;
         break;
     case Type::STRING:
-        new (&m_string) String(std::move(value.m_string));
+        delete m_storage.string;
         break;
     case Type::NUMBER:
-        new (&m_number) Number(std::move(value.m_number));
-        break;
-    case Type::BOOLEAN:
-        m_boolean = value.m_boolean;
-        break;
-    case Type::NIL:
-    default:
-        break;
-    }
-}
-
-Value::~Value() {
-    switch (m_type) {
-    case Type::OBJECT:
-        m_object.~vector();
-        break;
-    case Type::ARRAY:
-        m_array.~vector();
-        break;
-    case Type::STRING:
-        m_string.~basic_string();
-        break;
-    case Type::NUMBER:
-        m_number.~Number();
-        break;
     case Type::BOOLEAN:
     case Type::NIL:
     default:
@@ -201,22 +192,22 @@ Value::~Value() {
 
 Value& Value::operator=(const Value& value) {
     if (this != &value) {
-        if (value.m_type == m_type) {
-            switch (m_type) {
+        if (value.get_type() == get_type()) {
+            switch (get_type()) {
             case Type::OBJECT:
-                m_object = value.m_object;
+                *m_storage.object = *value.m_storage.object;
                 break;
             case Type::ARRAY:
-                m_array = value.m_array;
+                *m_storage.array = *value.m_storage.array;
                 break;
             case Type::STRING:
-                m_string = value.m_string;
+                *m_storage.string = *value.m_storage.string;
                 break;
             case Type::NUMBER:
                 m_number = value.m_number;
                 break;
             case Type::BOOLEAN:
-                m_boolean = value.m_boolean;
+                m_storage.boolean = value.m_storage.boolean;
                 break;
             case Type::NIL:
             default:
@@ -224,87 +215,14 @@ Value& Value::operator=(const Value& value) {
             }
         }
         else {
-            this->~Value();
-            m_type = value.m_type;
-            switch (m_type) {
-            case Type::OBJECT:
-                new (&m_object) Object(value.m_object);
-                break;
-            case Type::ARRAY:
-                new (&m_array) Array(value.m_array);
-                break;
-            case Type::STRING:
-                new (&m_string) String(value.m_string);
-                break;
-            case Type::NUMBER:
-                new (&m_number) Number(value.m_number);
-                break;
-            case Type::BOOLEAN:
-                m_boolean = value.m_boolean;
-                break;
-            case Type::NIL:
-            default:
-                break;
-            }
-        }
-    }
-    return *this;
-}
-
-Value& Value::operator=(Value&& value) {
-    if (this != &value) {
-        if (value.m_type == m_type) {
-            switch (m_type) {
-            case Type::OBJECT:
-                m_object = std::move(value.m_object);
-                break;
-            case Type::ARRAY:
-                m_array = std::move(value.m_array);
-                break;
-            case Type::STRING:
-                m_string = std::move(value.m_string);
-                break;
-            case Type::NUMBER:
-                m_number = std::move(value.m_number);
-                break;
-            case Type::BOOLEAN:
-                m_boolean = value.m_boolean;
-                break;
-            case Type::NIL:
-            default:
-                break;
-            }
-        }
-        else {
-            this->~Value();
-            m_type = value.m_type;
-            switch (m_type) {
-            case Type::OBJECT:
-                new (&m_object) Object(std::move(value.m_object));
-                break;
-            case Type::ARRAY:
-                new (&m_array) Array(std::move(value.m_array));
-                break;
-            case Type::STRING:
-                new (&m_string) String(std::move(value.m_string));
-                break;
-            case Type::NUMBER:
-                new (&m_number) Number(std::move(value.m_number));
-                break;
-            case Type::BOOLEAN:
-                m_boolean = value.m_boolean;
-                break;
-            case Type::NIL:
-            default:
-                break;
-            }
+            *this = Value(value);
         }
     }
     return *this;
 }
 
 Value& Value::operator+=(const Value& value) {
-    switch (m_type) {
+    switch (get_type()) {
     case Type::OBJECT:
         if (value.is_object()) {
             for (auto it = value.cbegin(); value.cend() != it; ++it) {
@@ -314,22 +232,22 @@ Value& Value::operator+=(const Value& value) {
         break;
     case Type::ARRAY:
         if (value.is_array()) {
-            m_array.insert(m_array.end(),
-                    value.m_array.begin(),
-                    value.m_array.end());
+            m_storage.array->insert(m_storage.array->end(),
+                    value.m_storage.array->begin(),
+                    value.m_storage.array->end());
         }
         else if (value.is_object()) {
-             m_array.insert(m_array.end(),
-                    value.m_object.begin(),
-                    value.m_object.end());
+             m_storage.array->insert(m_storage.array->end(),
+                    value.m_storage.object->begin(),
+                    value.m_storage.object->end());
         }
         else {
-            m_array.push_back(value);
+            m_storage.array->push_back(value);
         }
         break;
     case Type::STRING:
         if (value.is_string()) {
-            m_string += value.m_string;
+            *m_storage.string += *value.m_storage.string;
         }
         break;
     case Type::NUMBER:
@@ -350,12 +268,11 @@ Value& Value::operator+=(const Value& value) {
 
 void Value::assign(std::initializer_list<Pair> init_list) {
     if (!is_object()) {
-        this->~Value();
-        m_type = Type::OBJECT;
-        new (&m_object) Object();
+        *this = Type::OBJECT;
     }
     else {
-        m_object.clear();
+        m_storage.object->clear();
+        m_storage.object->reindex();
     }
 
     for (auto it = init_list.begin(); it < init_list.end(); ++it) {
@@ -365,35 +282,31 @@ void Value::assign(std::initializer_list<Pair> init_list) {
 
 void Value::assign(std::initializer_list<Value> init_list) {
     if (is_array()) {
-        m_array.assign(init_list);
+        m_storage.array->assign(init_list);
     }
     else {
-        this->~Value();
-        m_type = Type::ARRAY;
-        new (&m_array) Array(init_list);
+        *this = Value(init_list);
     }
 }
 
 void Value::assign(std::size_t count, const Value& value) {
     if (is_array()) {
-        m_array.assign(count, value);
+        m_storage.array->assign(count, value);
     }
     else {
-        this->~Value();
-        m_type = Type::ARRAY;
-        new (&m_array) Array(count, value);
+        *this = Value(count, value);
     }
 }
 
 std::size_t Value::size() const {
     std::size_t value;
 
-    switch (m_type) {
+    switch (get_type()) {
     case Type::OBJECT:
-        value = m_object.size();
+        value = m_storage.object->size();
         break;
     case Type::ARRAY:
-        value = m_array.size();
+        value = m_storage.array->size();
         break;
     case Type::STRING:
     case Type::NIL:
@@ -408,21 +321,22 @@ std::size_t Value::size() const {
 }
 
 void Value::clear() {
-    switch (m_type) {
+    switch (get_type()) {
     case Type::OBJECT:
-        m_object.clear();
+        m_storage.object->clear();
+        m_storage.object->reindex();
         break;
     case Type::ARRAY:
-        m_array.clear();
+        m_storage.array->clear();
         break;
     case Type::STRING:
-        m_string.clear();
+        m_storage.string->clear();
         break;
     case Type::NUMBER:
         m_number = 0;
         break;
     case Type::BOOLEAN:
-        m_boolean = false;
+        m_storage.boolean = false;
         break;
     case Type::NIL:
     default:
@@ -433,23 +347,22 @@ void Value::clear() {
 std::size_t Value::erase(const char* key) {
     if (!is_object()) { return 0; }
 
-    for (auto it = m_object.begin(); it != m_object.end(); ++it) {
-        if (it->first == key) {
-            m_object.erase(it);
-            return 1;
-        }
-    }
-    return 0;
+    const Pair* pair = m_storage.object->find(key);
+    if (nullptr == pair) { return 0; }
+
+    m_storage.object->erase(m_storage.object->cbegin() +
+            (pair - m_storage.object->data()));
+    return 1;
 }
 
 Value::iterator Value::erase(const_iterator pos) {
     iterator tmp;
 
     if (is_array() && pos.is_array()) {
-        tmp = m_array.erase(pos.m_array_iterator);
+        tmp = m_storage.array->erase(pos.m_array_iterator);
     }
     else if (is_object() && pos.is_object()) {
-        tmp = m_object.erase(pos.m_object_iterator);
+        tmp = m_storage.object->erase(pos.m_object_iterator);
     }
     else {
         tmp = end();
@@ -461,8 +374,16 @@ Value::iterator Value::erase(const_iterator pos) {
 Value::iterator Value::erase(const_iterator first, const_iterator last) {
     iterator tmp;
 
-    for (auto it = first; it < last; ++it) {
-        tmp = erase(it);
+    if (is_array() && first.is_array() && last.is_array()) {
+        tmp = m_storage.array->erase(first.m_array_iterator,
+                last.m_array_iterator);
+    }
+    else if (is_object() && first.is_object() && last.is_object()) {
+        tmp = m_storage.object->erase(first.m_object_iterator,
+                last.m_object_iterator);
+    }
+    else {
+        tmp = end();
     }
 
     return tmp;
@@ -472,15 +393,12 @@ Value::iterator Value::insert(const_iterator pos, const Value& value) {
     iterator tmp;
 
     if (is_array() && pos.is_array()) {
-        tmp = m_array.insert(pos.m_array_iterator, value);
+        tmp = m_storage.array->insert(pos.m_array_iterator, value);
     }
     else if (is_object() && pos.is_object() && value.is_object()) {
-        for (auto it = value.cbegin(); value.cend() != it; ++it, ++pos) {
-            if (!is_member(it.key())) {
-                tmp = m_object.insert(pos.m_object_iterator,
-                            Pair(it.key(), *it));
-            }
-        }
+        Members members;
+        collect_members(value, members);
+        tmp = insert_members(pos, members);
     }
     else {
         tmp = end();
@@ -493,15 +411,13 @@ Value::iterator Value::insert(const_iterator pos, Value&& value) {
     iterator tmp;
 
     if (is_array() && pos.is_array()) {
-        tmp = m_array.insert(pos.m_array_iterator, std::move(value));
+        tmp = m_storage.array->insert(pos.m_array_iterator,
+                std::move(value));
     }
     else if (is_object() && pos.is_object() && value.is_object()) {
-        for (auto it = value.cbegin(); value.cend() != it; ++it, ++pos) {
-            if (!is_member(it.key())) {
-                tmp = m_object.insert(pos.m_object_iterator,
-                            Pair(it.key(), std::move(*it)));
-            }
-        }
+        Members members;
+        collect_members(std::move(value), members);
+        tmp = insert_members(pos, members);
     }
     else {
         tmp = end();
@@ -525,10 +441,68 @@ Value::iterator Value::insert(const_iterator pos,
         const_iterator first, const_iterator last) {
     iterator tmp;
 
-    for (auto it = first; it < last; ++it) {
-        tmp = insert(pos++, *it);
+    if (is_array() && pos.is_array()) {
+        /* Copy first, range may point to this array */
+        Array values;
+        values.reserve(std::size_t(last - first));
+        for (auto it = first; it < last; ++it) {
+            values.push_back(*it);
+        }
+
+        tmp = m_storage.array->insert(pos.m_array_iterator,
+                std::make_move_iterator(values.begin()),
+                std::make_move_iterator(values.end()));
+    }
+    else if (is_object() && pos.is_object()) {
+        Members members;
+        for (auto it = first; it < last; ++it) {
+            if (it->is_object()) { collect_members(*it, members); }
+        }
+        tmp = insert_members(pos, members);
+    }
+    else {
+        tmp = end();
+    }
+
+    return tmp;
+}
+
+/*!
+ * Members that are already in this object or in collected members are
+ * skipped, so the first member with given key is kept
+ * */
+void Value::collect_members(const Value& value, Members& members) const {
+    for (const auto& pair : *value.m_storage.object) {
+        const char* key = pair.first.c_str();
+        if (!is_member(key) && (nullptr == members.find(key))) {
+            members.append(key) = pair.second;
+        }
+    }
+}
+
+void Value::collect_members(Value&& value, Members& members) const {
+    for (auto& pair : *value.m_storage.object) {
+        const char* key = pair.first.c_str();
+        if (!is_member(key) && (nullptr == members.find(key))) {
+            members.append(key) = std::move(pair.second);
+        }
+    }
+}
+
+/*!
+ * All members are inserted at once and members index is rebuilt once
+ * */
+Value::iterator Value::insert_members(const_iterator pos, Members& members) {
+    if (members.empty()) {
+        return m_storage.object->begin() +
+            (pos.m_object_iterator - m_storage.object->cbegin());
     }
 
+    iterator tmp = m_storage.object->insert(pos.m_object_iterator,
+            std::make_move_iterator(members.begin()),
+            std::make_move_iterator(members.end()));
+    m_storage.object->reindex();
+
     return tmp;
 }
 
@@ -544,12 +518,12 @@ Value& Value::operator[](std::size_t index) {
 
     if (is_array()) {
         if (size() == index) {
-            m_array.emplace_back(nullptr);
+            m_storage.array->emplace_back(nullptr);
         }
-        ptr = &m_array[index];
+        ptr = &(*m_storage.array)[index];
     }
     else  if (is_object()) {
-        ptr = &m_object[index].second;
+        ptr = &(*m_storage.object)[index].second;
     }
     else {
         ptr = this;
@@ -562,10 +536,10 @@ const Value& Value::operator[](std::size_t index) const {
     const Value* ptr;
 
     if (is_array()) {
-        ptr = &m_array[index];
+        ptr = &(*m_storage.array)[index];
     }
     else if (is_object()) {
-        ptr = &m_object[index].second;
+        ptr = &(*m_storage.object)[index].second;
     }
     else {
         ptr = this;
@@ -580,14 +554,10 @@ Value& Value::operator[](const char* key) {
         else { return *this; }
     }
 
-    for (auto& pair : m_object) {
-        if (pair.first == key) {
-            return pair.second;
-        }
-    }
+    Pair* pair = m_storage.object->find(key);
+    if (nullptr != pair) { return pair->second; }
 
-    m_object.emplace_back(key, nullptr);
-    return m_object.back().second;
+    return m_storage.object->append(key);
 }
 
 const Value& Value::operator[](const char* key) const {
@@ -595,11 +565,8 @@ const Value& Value::operator[](const char* key) const {
 
     if (!is_object()) { return *this; }
 
-    for (const auto& pair : m_object) {
-        if (pair.first == key) {
-            return pair.second;
-        }
-    }
+    const Pair* pair = m_storage.object->find(key);
+    if (nullptr != pair) { return pair->second; }
 
     return null_value;
 }
@@ -608,7 +575,23 @@ void Value::push_back(const Value& value) {
     if (is_null()) { *this = Value(Type::ARRAY); }
 
     if (is_array()) {
-        m_array.push_back(value);
+        m_storage.array->push_back(value);
+    }
+}
+
+void Value::push_back(Value&& value) {
+    if (is_null()) { *this = Value(Type::ARRAY); }
+
+    if (is_array()) {
+        m_storage.array->push_back(std::move(value));
+    }
+}
+
+void Value::append(String&& key, Value&& value) {
+    if (is_null()) { *this = Type::OBJECT; }
+
+    if (is_object()) {
+        m_storage.object->append(std::move(key)) = std::move(value);
     }
 }
 
@@ -619,16 +602,16 @@ void Value::push_back(const Pair& pair) {
         (*this)[pair.first] = pair.second;
     }
     else if (is_array()) {
-        m_array.push_back(pair);
+        m_storage.array->push_back(pair);
     }
 }
 
 void Value::pop_back() {
     if (is_array()) {
-        m_array.pop_back();
+        m_storage.array->pop_back();
     }
     else if (is_object()) {
-        m_object.pop_back();
+        m_storage.object->pop_back();
     }
     else {
         *this = Type::NIL;
@@ -644,125 +627,119 @@ void Value::swap(Value& value) {
 bool Value::is_member(const char* key) const {
     if (!is_object()) { return false; }
 
-    for (const auto& pair : m_object) {
-        if (pair.first == key) {
-            return true;
-        }
-    }
-
-    return false;
+    return nullptr != m_storage.object->find(key);
 }
 
 json::String& Value::as_string() {
-    if (Type::STRING != m_type) {
+    if (Type::STRING != get_type()) {
         throw ValueError(ValueError::NOT_STRING);
     }
-    return m_string;
+    return *m_storage.string;
 }
 
 const json::String& Value::as_string() const {
-    if (Type::STRING != m_type) {
+    if (Type::STRING != get_type()) {
         throw ValueError(ValueError::NOT_STRING);
     }
-    return m_string;
+    return *m_storage.string;
 }
 
 const char* Value::as_char() const {
-    if (Type::STRING != m_type) {
+    if (Type::STRING != get_type()) {
         throw ValueError(ValueError::NOT_STRING);
     }
-    return m_string.c_str();
+    return m_storage.string->c_str();
 }
 
 json::Bool Value::as_bool() const {
-    if (Type::BOOLEAN != m_type) {
+    if (Type::BOOLEAN != get_type()) {
         throw ValueError(ValueError::NOT_BOOLEAN);
     }
-    return m_boolean;
+    return m_storage.boolean;
 }
 
 json::Null Value::as_null() const {
-    if (Type::NIL != m_type) {
+    if (Type::NIL != get_type()) {
         throw ValueError(ValueError::NOT_NULL);
     }
     return nullptr;
 }
 
 json::Int Value::as_int() const {
-    if (Type::NUMBER != m_type) {
+    if (Type::NUMBER != get_type()) {
         throw ValueError(ValueError::NOT_NUMBER);
     }
     return Int(m_number);
 }
 
 json::Uint Value::as_uint() const {
-    if (Type::NUMBER != m_type) {
+    if (Type::NUMBER != get_type()) {
         throw ValueError(ValueError::NOT_NUMBER);
     }
     return Uint(m_number);
 }
 
 json::Double Value::as_double() const {
-    if (Type::NUMBER != m_type) {
+    if (Type::NUMBER != get_type()) {
         throw ValueError(ValueError::NOT_NUMBER);
     }
     return Double(m_number);
 }
 
 json::Array& Value::as_array() {
-    if (Type::ARRAY != m_type) {
+    if (Type::ARRAY != get_type()) {
         throw ValueError(ValueError::NOT_ARRAY);
     }
-    return m_array;
+    return *m_storage.array;
 }
 
 json::Number& Value::as_number() {
-    if (Type::NUMBER != m_type) {
+    if (Type::NUMBER != get_type()) {
         throw ValueError(ValueError::NOT_NUMBER);
     }
     return m_number;
 }
 
 const json::Array& Value::as_array() const {
-    if (Type::ARRAY != m_type) {
+    if (Type::ARRAY != get_type()) {
         throw ValueError(ValueError::NOT_ARRAY);
     }
-    return m_array;
+    return *m_storage.array;
 }
 
 const json::Object& Value::as_object() const {
-    if (Type::OBJECT != m_type) {
+    if (Type::OBJECT != get_type()) {
         throw ValueError(ValueError::NOT_OBJECT);
     }
-    return m_object;
+    return *m_storage.object;
 }
 
 const json::Number& Value::as_number() const {
-    if (Type::NUMBER != m_type) {
+    if (Type::NUMBER != get_type()) {
         throw ValueError(ValueError::NOT_NUMBER);
     }
     return m_number;
 }
 
 bool Value::operator==(const json::Value& other) const {
-    if (m_type != other.m_type) { return false; }
+    if (get_type() != other.get_type()) { return false; }
     bool result;
 
-    switch (m_type) {
+    switch (get_type()) {
     case Value::Type::OBJECT:
-        result = (m_object == other.m_object);
+        result = (*m_storage.object == *other.m_storage.object);
         break;
     case Value::Type::ARRAY:
-        result = (m_array == other.m_array);
+        result = (*m_storage.array == *other.m_storage.array);
         break;
     case Value::Type::STRING:
-        result = (m_string == other.m_string);
+        result = (*m_storage.string == *other.m_storage.string);
         break;
     case Value::Type::NUMBER:
         result = (m_number == other.m_number);
         break;
     case Value::Type::BOOLEAN:
-        result = (m_boolean == other.m_boolean);
+        result = (m_storage.boolean == other.m_storage.boolean);
         break;
     case Value::Type::NIL:
         result = true;
@@ -776,24 +753,24 @@ bool Value::operator==(const json::Value& other) const {
 }
 
 bool Value::operator<(const json::Value& val) const {
-    if (m_type != val.m_type) { return false; }
+    if (get_type() != val.get_type()) { return false; }
     bool result;
 
-    switch (m_type) {
+    switch (get_type()) {
     case Value::Type::OBJECT:
-        result = (m_object < val.m_object);
+        result = (*m_storage.object < *val.m_storage.object);
         break;
     case Value::Type::ARRAY:
-        result = (m_array < val.m_array);
+        result = (*m_storage.array < *val.m_storage.array);
         break;
     case Value::Type::STRING:
-        result = (m_string < val.m_string);
+        result = (*m_storage.string < *val.m_storage.string);
         break;
     case Value::Type::NUMBER:
         result = (m_number < val.m_number);
         break;
     case Value::Type::BOOLEAN:
-        result = (m_boolean < val.m_boolean);
+        result = (m_storage.boolean < val.m_storage.boolean);
         break;
     case Value::Type::NIL:
     default:
@@ -808,10 +785,10 @@ Value::iterator Value::begin() {
     iterator tmp;
 
     if (is_array()) {
-        tmp = m_array.begin();
+        tmp = m_storage.array->begin();
     }
     else if (is_object()) {
-        tmp = m_object.begin();
+        tmp = m_storage.object->begin();
     }
     else {
         tmp = this;
@@ -824,10 +801,10 @@ Value::iterator Value::end() {
     iterator tmp;
 
     if (is_array()) {
-        tmp = m_array.end();
+        tmp = m_storage.array->end();
     }
     else if (is_object()) {
-        tmp = m_object.end();
+        tmp = m_storage.object->end();
     }
     else {
         tmp = this;
@@ -840,10 +817,10 @@ Value::const_iterator Value::cbegin() const {
     const_iterator tmp;
 
     if (is_array()) {
-        tmp = m_array.cbegin();
+        tmp = m_storage.array->cbegin();
     }
     else if (is_object()) {
-        tmp = m_object.cbegin();
+        tmp = m_storage.object->cbegin();
     }
     else {
         tmp = this;
@@ -856,10 +833,10 @@ Value::const_iterator Value::cend() const {
     const_iterator tmp;
 
     if (is_array()) {
-        tmp = m_array.cend();
+        tmp = m_storage.array->cend();
     }
     else if (is_object()) {
-        tmp = m_object.cend();
+        tmp = m_storage.object->cend();
     }
     else {
         tmp = this;
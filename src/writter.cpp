@@ -47,4 +47,6 @@ using json::Writter;
 
 Writter::Writter() { }
 
+void Writter::flush() { }
+
 Writter::~Writter() { }
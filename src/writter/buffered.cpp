@@ -0,0 +1,108 @@
+/*!
+ * @copyright
+ * Copyright (c) 2015, Tymoteusz Blazejczyk
+ *
+ * @copyright
+ * All rights reserved.
+ *
+ * @copyright
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * @copyright
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * @copyright
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * @copyright
+ * * Neither the name of json-cxx nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * @copyright
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file writter/buffered.cpp
+ *
+ * @brief JSON writter implementation
+ * */
+
+#include "json/writter/buffered.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+using json::writter::Buffered;
+
+Buffered::Buffered(std::size_t buffer_size) :
+    m_buffer(std::max<std::size_t>(buffer_size, 1)),
+    m_length{0}
+{ }
+
+Buffered::~Buffered() { }
+
+void Buffered::clear() {
+    m_length = 0;
+}
+
+void Buffered::write(char ch) {
+    if (m_buffer.size() == m_length) { flush(); }
+    m_buffer[m_length++] = ch;
+}
+
+void Buffered::write(std::size_t size, char ch) {
+    while (size > 0) {
+        if (m_buffer.size() == m_length) { flush(); }
+
+        std::size_t chunk = std::min(size, m_buffer.size() - m_length);
+        std::memset(m_buffer.data() + m_length, ch, chunk);
+        m_length += chunk;
+        size -= chunk;
+    }
+}
+
+void Buffered::write(const char* str) {
+    write(str, std::strlen(str));
+}
+
+void Buffered::write(const char* str, std::size_t length) {
+    if (length > (m_buffer.size() - m_length)) {
+        flush();
+
+        /* Don't copy data that would fill whole buffer anyway */
+        if (length >= m_buffer.size()) {
+            output(str, length);
+            return;
+        }
+    }
+
+    std::memcpy(m_buffer.data() + m_length, str, length);
+    m_length += length;
+}
+
+void Buffered::write(const std::string& str) {
+    write(str.data(), str.size());
+}
+
+void Buffered::flush() {
+    if (0 != m_length) {
+        /* Reset first, buffer is not written twice when output throws */
+        std::size_t length = m_length;
+        m_length = 0;
+        output(m_buffer.data(), length);
+    }
+}
@@ -0,0 +1,141 @@
+/*!
+ * @copyright
+ * Copyright (c) 2015, Tymoteusz Blazejczyk
+ *
+ * @copyright
+ * All rights reserved.
+ *
+ * @copyright
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * @copyright
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * @copyright
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * @copyright
+ * * Neither the name of json-cxx nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * @copyright
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#include "gtest/gtest.h"
+
+#include <string>
+
+#include "json/value.hpp"
+#include "json/cursor.hpp"
+#include "json/iterator.hpp"
+#include "json/deserializer.hpp"
+#include "json/deserializer_error.hpp"
+#include "json/value_error.hpp"
+
+using json::Value;
+using json::Cursor;
+using json::Deserializer;
+using json::DeserializerError;
+
+class CursorTest : public ::testing::Test {
+protected:
+    virtual ~CursorTest();
+};
+
+CursorTest::~CursorTest() { }
+
+static const char* const TEST_JSON = R"({
+    "string": "text \"quoted\" é",
+    "numbers": [0, -1, 2147483647, 3.5, 1e-3],
+    "literals": [true, false, null],
+    "nested": {"empty_object": {}, "empty_array": [], "array": [[1], [2]]},
+    "tricky": ["}]", "\\", {"a": "[{"}],
+    "escaped": 7,
+    "last": "value"
+})";
+
+TEST_F(CursorTest, PositiveAccess) {
+    const Cursor root(TEST_JSON);
+
+    ASSERT_TRUE(root.is_object());
+    EXPECT_EQ(root.size(), 7u);
+    EXPECT_EQ(root["string"].as_string(), "text \"quoted\" é");
+    EXPECT_EQ(root["numbers"].size(), 5u);
+    EXPECT_EQ(root["numbers"][1].as_int(), -1);
+    EXPECT_DOUBLE_EQ(root["numbers"][3].as_double(), 3.5);
+    EXPECT_TRUE(root["literals"][0].as_bool());
+    EXPECT_FALSE(root["literals"][1].as_bool());
+    EXPECT_TRUE(root["literals"][2].is_null());
+    EXPECT_TRUE(root["literals"][2].is_valid());
+    EXPECT_TRUE(root["nested"]["empty_object"].empty());
+    EXPECT_TRUE(root["nested"]["empty_array"].is_array());
+    EXPECT_EQ(root["nested"]["array"][1][0].as_uint(), 2u);
+    EXPECT_EQ(root["escaped"].as_int(), 7);
+    EXPECT_EQ(root["last"].as_string(), "value");
+    EXPECT_EQ(root[6].as_string(), "value");
+}
+
+TEST_F(CursorTest, PositiveMissing) {
+    const Cursor root(TEST_JSON);
+
+    EXPECT_FALSE(root["missing"].is_valid());
+    EXPECT_TRUE(root["missing"].is_null());
+    EXPECT_FALSE(root.is_member("missing"));
+    EXPECT_TRUE(root.is_member("tricky"));
+    EXPECT_FALSE(root["numbers"][5].is_valid());
+    EXPECT_FALSE(root["string"]["key"].is_valid());
+    EXPECT_FALSE(root["missing"]["key"][0].is_valid());
+    EXPECT_FALSE(Cursor("  ").is_valid());
+}
+
+TEST_F(CursorTest, PositiveToValue) {
+    const Cursor root(TEST_JSON);
+
+    EXPECT_EQ(root.to_value(), Deserializer(TEST_JSON).get_value());
+    EXPECT_EQ(root["tricky"].to_value(),
+            Deserializer(R"(["}]", "\\", {"a": "[{"}])").get_value());
+}
+
+TEST_F(CursorTest, NegativeTypes) {
+    const Cursor root(TEST_JSON);
+
+    EXPECT_THROW(root["numbers"].as_string(), json::ValueError);
+    EXPECT_THROW(root["string"].as_number(), json::ValueError);
+    EXPECT_THROW(root["string"].as_bool(), json::ValueError);
+}
+
+TEST_F(CursorTest, NegativeInvalid) {
+    const std::string str{R"({"a": [1, 2}, "b": tru})"};
+    const Cursor root(str);
+
+    /* Skipped values are not validated */
+    EXPECT_EQ(root["b"].get_type(), Cursor::Type::BOOLEAN);
+
+    try {
+        root["b"].as_bool();
+        FAIL();
+    }
+    catch (const DeserializerError& error) {
+        EXPECT_EQ(error.get_code(), DeserializerError::END_OF_FILE);
+        EXPECT_EQ(error.get_offset(), str.find("tru"));
+    }
+
+    EXPECT_THROW(Cursor(R"({"a": "text)")["b"], DeserializerError);
+    EXPECT_THROW(Cursor(R"({"a" 1})")["a"], DeserializerError);
+}
@@ -39,6 +39,17 @@
 
 #include "gtest/gtest.h"
 
+#include <random>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <system_error>
+
+#include <unistd.h>
+
 #include "json/value.hpp"
 #include "json/iterator.hpp"
 #include "json/deserializer.hpp"
@@ -220,3 +231,538 @@ TEST_F(DeserializerTest, NegativeExtNulll) {
     ASSERT_THROW("nulll" >> value, DeserializerError);
     EXPECT_EQ(value, nullptr);
 }
+
+TEST_F(DeserializerTest, PositiveLargeArray) {
+    const std::size_t count = 1000000;
+    std::string str{"["};
+    Value value;
+
+    for (std::size_t i = 0; i < count; ++i) {
+        str += std::to_string(i % 10);
+        str += ',';
+    }
+    str.back() = ']';
+
+    ASSERT_NO_THROW(str >> value);
+    EXPECT_TRUE(value.is_array());
+    ASSERT_EQ(value.size(), count);
+    EXPECT_EQ(value[0], 0);
+    EXPECT_EQ(value[count - 1], 9);
+}
+
+TEST_F(DeserializerTest, PositiveDeepNesting) {
+    const std::size_t depth = 1000;
+    std::string str(depth, '[');
+    Value value;
+
+    str.append(depth, ']');
+
+    ASSERT_NO_THROW(str >> value);
+    EXPECT_TRUE(value.is_array());
+    EXPECT_EQ(value.size(), 1);
+}
+
+TEST_F(DeserializerTest, PositiveNestedObject) {
+    Value value;
+
+    ASSERT_NO_THROW(R"({"a":[1,{"b":[]}],"c":{},"d":"e"})" >> value);
+    EXPECT_TRUE(value.is_object());
+    ASSERT_EQ(value.size(), 3);
+    EXPECT_EQ(value["a"][0], 1);
+    EXPECT_TRUE(value["a"][1]["b"].is_array());
+    EXPECT_TRUE(value["c"].is_object());
+    EXPECT_EQ(value["d"], "e");
+    EXPECT_STREQ(value.cbegin().key(), "a");
+}
+
+TEST_F(DeserializerTest, NegativeUnclosedContainers) {
+    for (const char* test : {
+        "[1, 2",
+        "[1 2]",
+        "{\"a\":1",
+        "{\"a\":1]",
+        "[{\"a\":1]"
+    }) {
+        Value value;
+        EXPECT_THROW(test >> value, DeserializerError);
+    }
+}
+
+TEST_F(DeserializerTest, PositiveLongWhitespaces) {
+    for (std::size_t length : {1u, 15u, 16u, 17u, 31u, 32u, 33u, 100u}) {
+        const std::string indent = " \t\r\n" + std::string(length, ' ');
+        Value value;
+
+        ASSERT_NO_THROW((indent + "{" + indent + "\"key\"" + indent + ":"
+                    + indent + "[" + indent + "1" + indent + "," + indent
+                    + "2" + indent + "]" + indent + "}" + indent) >> value);
+        EXPECT_TRUE(value.is_object());
+        EXPECT_EQ(value["key"].size(), 2);
+        EXPECT_EQ(value["key"][1], 2);
+    }
+}
+
+TEST_F(DeserializerTest, NegativeOnlyWhitespaces) {
+    Value value;
+
+    ASSERT_NO_THROW(std::string(100, ' ') >> value);
+    EXPECT_TRUE(value.is_null());
+    EXPECT_THROW(("[" + std::string(100, ' ')) >> value, DeserializerError);
+}
+
+TEST_F(DeserializerTest, PositiveStringEscapes) {
+    Value value;
+
+    ASSERT_NO_THROW(R"(["abcdefghijklmnopqrstuvwxyz0123456789ABCDEFGHIJ\"\\\/\b\f\n\r\t\u0041\u00e9\u20AC\uD83D\uDE00end"])" >> value);
+    ASSERT_TRUE(value[0].is_string());
+    EXPECT_EQ(value[0].as_string(),
+            "abcdefghijklmnopqrstuvwxyz0123456789ABCDEFGHIJ\"\\/\b\f\n\r\t"
+            "A\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80" "end");
+}
+
+TEST_F(DeserializerTest, PositiveLongString) {
+    const std::string str(1000, 'x');
+    Value value;
+
+    ASSERT_NO_THROW(("{\"" + str + "\":\"" + str + "\\n\"}") >> value);
+    EXPECT_EQ(value[str], str + "\n");
+}
+
+TEST_F(DeserializerTest, NegativeStringControlCharacter) {
+    for (const char* test : {
+        "\"a\nb\"",
+        "\"abcdefghijklmnopqrstuvwxyz\tb\"",
+        "[\"\x01\"]",
+        "\"abc",
+        "\"abc\\",
+        "\"\\x\""
+    }) {
+        Value value;
+        EXPECT_THROW(test >> value, DeserializerError);
+    }
+}
+
+TEST_F(DeserializerTest, PositiveNumberCorrectRounding) {
+    for (const char* test : {
+        "1e23",
+        "8.41e21",
+        "9007199254740993.0",
+        "9007199254740993.000000000000000000000000000000000000000001",
+        "2.2250738585072011e-308",
+        "2.2250738585072012e-308",
+        "4.9e-324",
+        "2.4703282292062327e-324",
+        "2.4703282292062328e-324",
+        "1.7976931348623157e308",
+        "1.7976931348623158e308",
+        "0.000000000000000000000000000000000000001e40",
+        "123456789012345678901234567890",
+        "-0.1",
+        "0.30000000000000004",
+        "1234567890.123456789",
+        "12345678901234567890.5",
+        "1e-400",
+        "1e400"
+    }) {
+        Value value;
+        ASSERT_NO_THROW(test >> value);
+        EXPECT_TRUE(value.is_double());
+        EXPECT_EQ(value.as_double(), std::strtod(test, nullptr)) << test;
+    }
+}
+
+TEST_F(DeserializerTest, PositiveNumberRandomRoundTrip) {
+    std::mt19937_64 generator(0);
+    char buffer[64];
+
+    for (int i = 0; i < 10000; ++i) {
+        json::Uint64 bits = generator();
+        json::Double number;
+
+        std::memcpy(&number, &bits, sizeof(number));
+        if (!std::isfinite(number)) { continue; }
+
+        std::snprintf(buffer, sizeof(buffer), "%.17e", number);
+
+        Value value;
+        ASSERT_NO_THROW(buffer >> value);
+        EXPECT_EQ(value.as_double(), number) << buffer;
+    }
+}
+
+TEST_F(DeserializerTest, PositiveNumberIntegerLimits) {
+    Value value;
+
+    ASSERT_NO_THROW("[18446744073709551615, -9223372036854775808, "
+            "18446744073709551616, -9223372036854775809, 1e2, -0, "
+            "9999999999999999999, -9223372036854775807]" >> value);
+    EXPECT_TRUE(value[0].is_uint());
+    EXPECT_TRUE(value[1].is_int());
+    EXPECT_TRUE(value[2].is_double());
+    EXPECT_EQ(value[2].as_double(), 18446744073709551616.0);
+    EXPECT_TRUE(value[3].is_double());
+    EXPECT_EQ(value[3].as_double(), -9223372036854775809.0);
+    EXPECT_TRUE(value[4].is_uint());
+    EXPECT_EQ(value[4], 100);
+    EXPECT_TRUE(value[5].is_int());
+    EXPECT_EQ(value[5], 0);
+    EXPECT_TRUE(value[6].is_uint());
+    EXPECT_EQ(json::Uint64(value[6]), 9999999999999999999u);
+    EXPECT_TRUE(value[7].is_int());
+    EXPECT_EQ(json::Int64(value[7]), -9223372036854775807);
+}
+
+TEST_F(DeserializerTest, NegativeNumberMalformed) {
+    for (const char* test : {
+        "-",
+        "-x",
+        "-.5",
+        "[01]",
+        "1.",
+        "1.e5",
+        "1e",
+        "1e+",
+        "[1e-]",
+        "[1.5ex]"
+    }) {
+        Value value;
+        EXPECT_THROW(test >> value, DeserializerError) << test;
+    }
+}
+
+TEST_F(DeserializerTest, PositiveMoveOut) {
+    Deserializer deserializer(R"({"key":[1, 2, 3]})");
+    Value value;
+
+    deserializer >> value;
+    EXPECT_EQ(value["key"].size(), 3);
+    EXPECT_EQ(deserializer.get_value(), value);
+
+    value = deserializer.release();
+    EXPECT_EQ(value["key"][2], 3);
+    EXPECT_TRUE(deserializer.get_value().is_null());
+
+    Deserializer(R"(["test"])") >> value;
+    EXPECT_EQ(value[0], "test");
+}
+
+TEST_F(DeserializerTest, PositiveChainedExtraction) {
+    Value first;
+    Value second;
+
+    R"({"key1":1, "key2":2})" >> first >> second;
+    EXPECT_EQ(first["key2"], 2);
+    EXPECT_EQ(first, second);
+
+    Value third;
+    Value fourth;
+    std::string str{"[1, 2]"};
+
+    str >> third >> fourth;
+    EXPECT_EQ(third[1], 2);
+    EXPECT_EQ(third, fourth);
+
+    Deserializer deserializer("[1]");
+    deserializer >> first >> second;
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(deserializer.get_value(), first);
+}
+
+TEST_F(DeserializerTest, PositiveInPlace) {
+    Deserializer deserializer;
+    Value value;
+
+    deserializer.parsing(R"({"key":"test"})", value);
+    EXPECT_EQ(value["key"], "test");
+    EXPECT_TRUE(deserializer.get_value().is_null());
+
+    EXPECT_THROW(deserializer.parsing("[1, 2", value), DeserializerError);
+    EXPECT_TRUE(value.is_null());
+}
+
+TEST_F(DeserializerTest, PositiveParsingFile) {
+    char path[] = "/tmp/json-cxx-XXXXXX";
+    const std::string str{R"({"key":[1, 2, "text"]})"};
+    int fd = mkstemp(path);
+    Value value;
+
+    ASSERT_GE(fd, 0);
+    ASSERT_EQ(write(fd, str.data(), str.size()), ssize_t(str.size()));
+    close(fd);
+
+    Deserializer deserializer;
+    EXPECT_NO_THROW(deserializer.parsing_file(path, value));
+    unlink(path);
+
+    EXPECT_EQ(value, Deserializer(str).get_value());
+}
+
+TEST_F(DeserializerTest, PositiveParsingFileZeroSize) {
+    /* Procfs pseudo-file reports zero size, but it holds JSON number */
+    const char* path = "/proc/sys/kernel/pid_max";
+    Value value;
+
+    if (0 != access(path, R_OK)) { return; }
+
+    EXPECT_NO_THROW(Deserializer().parsing_file(path, value));
+    ASSERT_TRUE(value.is_number());
+    EXPECT_GT(value.as_uint(), 0u);
+}
+
+TEST_F(DeserializerTest, NegativeParsingFileMissing) {
+    Value value;
+
+    EXPECT_THROW(Deserializer().parsing_file("/nonexistent/file.json", value),
+            std::system_error);
+}
+
+static Value parse_indexed(const std::string& str) {
+    Deserializer deserializer;
+    Value value;
+
+    deserializer.set_structural_index(true);
+    deserializer.parsing(str, value);
+
+    return value;
+}
+
+TEST_F(DeserializerTest, PositiveStructuralIndex) {
+    std::vector<std::string> inputs{
+        "",
+        "  \n ",
+        "0",
+        " -12.5e3 ",
+        "\"text\"",
+        "[]",
+        "{}",
+        "[[], {}, [[]], {\"a\": {}}]",
+        R"({"key": [1, true, false, null, "x\"y\\", -0.5], "b": {"c": 2}})",
+        R"(["\\\\", "\\\"", "a\\", "A😀"])"
+    };
+
+    /* Escapes and strings across 64 characters blocks boundaries */
+    for (std::size_t i = 0; i < 130; ++i) {
+        inputs.push_back("[\"" + std::string(i, 'a') + "\\\\\\\"\", 1]");
+        inputs.push_back("{\"" + std::string(i, ' ') + "\": " +
+                std::string(i, ' ') + "12345}");
+        inputs.push_back(std::string(i, ' ') + "[\"" + std::string(i, '\\')
+                + std::string(i, '\\') + "\"]");
+    }
+
+    for (const auto& str : inputs) {
+        Value expected;
+        Deserializer().parsing(str, expected);
+        EXPECT_EQ(parse_indexed(str), expected) << str;
+    }
+}
+
+TEST_F(DeserializerTest, NegativeStructuralIndex) {
+    const std::vector<std::string> inputs{
+        "[",
+        "{\"a\"",
+        "{\"a\":",
+        "{\"a\" 1}",
+        "{1: 2}",
+        "[1 2]",
+        "[1,]",
+        "[1}",
+        "{\"a\": 1]",
+        "truex",
+        "[nul]",
+        "[1x]",
+        "[\"abc]",
+        "[\"a\\\"]",
+        "1 2",
+        "[] x",
+        "[01]",
+        "[-]"
+    };
+
+    for (const auto& str : inputs) {
+        EXPECT_THROW(parse_indexed(str), DeserializerError) << str;
+
+        try {
+            parse_indexed(str);
+        }
+        catch (const DeserializerError& error) {
+            try {
+                Value value;
+                Deserializer().parsing(str, value);
+                FAIL() << str;
+            }
+            catch (const DeserializerError& expected) {
+                EXPECT_EQ(error.get_code(), expected.get_code()) << str;
+            }
+        }
+    }
+}
+
+TEST_F(DeserializerTest, PositiveTryParsing) {
+    Value value;
+    Deserializer deserializer;
+
+    auto result = deserializer.try_parsing(
+            "{\"key\": [1, -2.5, \"str\\n\", true, null]}", value);
+
+    EXPECT_TRUE(result);
+    EXPECT_EQ(DeserializerError::NONE, result.code);
+    EXPECT_EQ(5, value["key"].size());
+    EXPECT_EQ(Value("str\n"), value["key"][2]);
+
+    result = deserializer.try_parsing("  ", value);
+    EXPECT_TRUE(result);
+    EXPECT_TRUE(value.is_null());
+}
+
+TEST_F(DeserializerTest, NegativeTryParsing) {
+    const std::vector<std::string> inputs{
+        "[",
+        "{\"a\"",
+        "{\"a\":",
+        "{\"a\" 1}",
+        "{1: 2}",
+        "[1 2]",
+        "[1,]",
+        "[1}",
+        "{\"a\": 1]",
+        "truex",
+        "[nul]",
+        "[fals]",
+        "[1x]",
+        "[\"abc]",
+        "[\"a\\x\"]",
+        "[\"\\u12g4\"]",
+        "[\"a\x01\"]",
+        "1 2",
+        "[] x",
+        "[01]",
+        "[-]",
+        "[1.]",
+        "[1e+]",
+        "[1.5ex]"
+    };
+
+    for (bool indexed : {false, true}) {
+        Deserializer deserializer;
+        deserializer.set_structural_index(indexed);
+
+        for (const auto& str : inputs) {
+            Value value{1};
+            const auto result = deserializer.try_parsing(str, value);
+
+            EXPECT_FALSE(result) << str;
+            EXPECT_TRUE(value.is_null()) << str;
+
+            try {
+                deserializer.parsing(str, value);
+                FAIL() << str;
+            }
+            catch (const DeserializerError& error) {
+                EXPECT_EQ(error.get_code(), result.code) << str;
+                EXPECT_EQ(error.get_offset(), result.offset) << str;
+            }
+        }
+    }
+}
+
+TEST_F(DeserializerTest, NegativeTryParsingLimit) {
+    Value value;
+    Deserializer deserializer;
+    deserializer.set_limit(2);
+
+    const auto result = deserializer.try_parsing("[1, 2, 3, 4]", value);
+
+    EXPECT_EQ(DeserializerError::STACK_LIMIT_REACHED, result.code);
+    EXPECT_TRUE(value.is_null());
+}
+
+TEST_F(DeserializerTest, PositiveValidate) {
+    const std::string padding(100, 'a');
+    const std::vector<std::string> inputs{
+        "{\"key\": [1, -2.5e10, 0.125, \"str\\n\\u00e9\", true, null, {}]}",
+        "[\"" + padding + "\xC3\xA9" + padding + "\"]",
+        "[\"\xE2\x82\xAC \xEF\xBF\xBF \xF0\x9F\x98\x80 \xF4\x8F\xBF\xBF\"]",
+        "[123456789012345678901234567890e-400]",
+        "  "
+    };
+
+    for (bool indexed : {false, true}) {
+        Deserializer deserializer;
+        deserializer.set_structural_index(indexed);
+
+        for (const auto& str : inputs) {
+            const auto result = deserializer.validate(str);
+
+            EXPECT_TRUE(result) << str;
+            EXPECT_EQ(0, result.offset) << str;
+        }
+    }
+}
+
+TEST_F(DeserializerTest, NegativeValidate) {
+    const std::vector<std::string> inputs{
+        "[",
+        "{\"a\" 1}",
+        "[1,]",
+        "[1}",
+        "[nul]",
+        "[\"a\\x\"]",
+        "[\"a\x01\"]",
+        "[] x",
+        "[01]",
+        "[1.5ex]"
+    };
+
+    for (bool indexed : {false, true}) {
+        Deserializer deserializer;
+        deserializer.set_structural_index(indexed);
+
+        for (const auto& str : inputs) {
+            Value value;
+            const auto expected = deserializer.try_parsing(str, value);
+            const auto result = deserializer.validate(str);
+
+            EXPECT_FALSE(result) << str;
+            EXPECT_EQ(expected.code, result.code) << str;
+            EXPECT_EQ(expected.offset, result.offset) << str;
+        }
+    }
+}
+
+TEST_F(DeserializerTest, NegativeValidateUtf8) {
+    const std::string padding(100, 'a');
+    const std::vector<std::string> inputs{
+        "[\"\x80\"]",
+        "[\"\xC0\xAF\"]",
+        "[\"\xC3\"]",
+        "[\"\xE0\x80\xAF\"]",
+        "[\"\xED\xA0\x80\"]",
+        "[\"\xF0\x80\x80\xAF\"]",
+        "[\"\xF4\x90\x80\x80\"]",
+        "[\"\xF5\x80\x80\x80\"]",
+        "[\"\xFF\"]",
+        "[\"\xE2\x82\""
+    };
+
+    for (bool indexed : {false, true}) {
+        Deserializer deserializer;
+        deserializer.set_structural_index(indexed);
+
+        for (const auto& str : inputs) {
+            const auto result = deserializer.validate(str);
+
+            EXPECT_EQ(DeserializerError::INVALID_UTF8, result.code) << str;
+            EXPECT_EQ(2, result.offset) << str;
+        }
+
+        auto result = deserializer.validate("[\"" + padding + "\xC0\"]");
+        EXPECT_EQ(DeserializerError::INVALID_UTF8, result.code);
+        EXPECT_EQ(2 + padding.size(), result.offset);
+
+        /* The first error is reported */
+        result = deserializer.validate("[x, \"\xFF\"]");
+        EXPECT_EQ(DeserializerError::MISS_VALUE, result.code);
+        result = deserializer.validate("[\"\xFF\", x]");
+        EXPECT_EQ(DeserializerError::INVALID_UTF8, result.code);
+    }
+}
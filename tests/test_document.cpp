@@ -0,0 +1,255 @@
+/*!
+ * @copyright
+ * Copyright (c) 2015, Tymoteusz Blazejczyk
+ *
+ * @copyright
+ * All rights reserved.
+ *
+ * @copyright
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * @copyright
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * @copyright
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * @copyright
+ * * Neither the name of json-cxx nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * @copyright
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#include "gtest/gtest.h"
+
+#include <array>
+#include <string>
+
+#include "json/value.hpp"
+#include "json/arena.hpp"
+#include "json/iterator.hpp"
+#include "json/document.hpp"
+#include "json/deserializer.hpp"
+#include "json/serializer.hpp"
+#include "json/deserializer_error.hpp"
+#include "json/value_error.hpp"
+
+using json::Node;
+using json::Value;
+using json::Arena;
+using json::Document;
+using json::DeserializerError;
+
+class DocumentTest : public ::testing::Test {
+protected:
+    virtual ~DocumentTest();
+};
+
+DocumentTest::~DocumentTest() { }
+
+static const char* const TEST_JSON = R"({
+    "string": "text \"quoted\" é",
+    "numbers": [0, -1, 18446744073709551615, 3.5, 1e-3],
+    "literals": [true, false, null],
+    "nested": {"empty_object": {}, "empty_array": [], "array": [[1], [2]]},
+    "string": "duplicated"
+})";
+
+TEST_F(DocumentTest, PositiveParsing) {
+    Document document;
+    document.parsing(TEST_JSON);
+
+    const Node& root = document.get_root();
+    ASSERT_TRUE(root.is_object());
+    ASSERT_EQ(root.size(), 5u);
+    EXPECT_STREQ(root.key(1), "numbers");
+
+    EXPECT_EQ(root["string"].as_string(), "text \"quoted\" \xC3\xA9");
+    EXPECT_EQ(root["string"].length(), 16u);
+
+    const Node& numbers = root["numbers"];
+    ASSERT_TRUE(numbers.is_array());
+    ASSERT_EQ(numbers.size(), 5u);
+    EXPECT_EQ(numbers[0].as_uint(), 0u);
+    EXPECT_EQ(numbers[1].as_int(), -1);
+    EXPECT_EQ(numbers[2].as_uint64(), 18446744073709551615u);
+    EXPECT_DOUBLE_EQ(numbers[3].as_double(), 3.5);
+    EXPECT_DOUBLE_EQ(numbers[4].as_double(), 1e-3);
+
+    EXPECT_TRUE(root["literals"][0].as_bool());
+    EXPECT_FALSE(root["literals"][1].as_bool());
+    EXPECT_TRUE(root["literals"][2].is_null());
+
+    EXPECT_TRUE(root["nested"]["empty_object"].is_object());
+    EXPECT_TRUE(root["nested"]["empty_object"].empty());
+    EXPECT_TRUE(root["nested"]["empty_array"].is_array());
+    EXPECT_EQ(root["nested"]["array"][1][0].as_int(), 2);
+
+    EXPECT_TRUE(root.is_member("literals"));
+    EXPECT_FALSE(root.is_member("missing"));
+    EXPECT_TRUE(root["missing"].is_null());
+    EXPECT_THROW(root["numbers"].as_string(), json::ValueError);
+}
+
+TEST_F(DocumentTest, PositiveToValue) {
+    Document document;
+    document.parsing(R"([{"a": 1, "b": [true, null, "x"]}, -2.5, "y"])");
+
+    Value value;
+    json::Deserializer(R"([{"a": 1, "b": [true, null, "x"]}, -2.5, "y"])")
+        >> value;
+
+    EXPECT_EQ(document.get_root().to_value(), value);
+}
+
+TEST_F(DocumentTest, PositiveToValueDuplicatedKeys) {
+    const char* str = R"({"a": 1, "b": {"c": 2, "c": [3]}, "a": "4"})";
+
+    Document document;
+    document.parsing(str);
+
+    Value value;
+    json::Deserializer(str) >> value;
+
+    const Value converted = document.get_root().to_value();
+    ASSERT_EQ(converted.size(), 3u);
+    ASSERT_EQ(converted["b"].size(), 2u);
+    EXPECT_EQ(converted[std::size_t(2)], Value("4"));
+    EXPECT_EQ(json::Serializer(converted).read(),
+            json::Serializer(value).read());
+}
+
+TEST_F(DocumentTest, PositiveToValueDeepNesting) {
+    const unsigned depth = 1000;
+    std::string str;
+
+    for (unsigned i = 0; i < depth; ++i) { str += "{\"k\":[1,"; }
+    str += "2";
+    for (unsigned i = 0; i < depth; ++i) { str += "]}"; }
+
+    Document document;
+    document.parsing(str);
+
+    Value value;
+    json::Deserializer(str) >> value;
+
+    const Value converted = document.get_root().to_value();
+    EXPECT_EQ(json::Serializer(converted).read(),
+            json::Serializer(value).read());
+}
+
+TEST_F(DocumentTest, PositiveReparsing) {
+    std::string str{"["};
+
+    for (unsigned i = 0; i < 10000; ++i) {
+        str += "{\"id\":" + std::to_string(i) + ",\"name\":\"item\"},";
+    }
+    str += "null]";
+
+    Document document(1024);
+    document.parsing(str);
+    ASSERT_EQ(document.get_root().size(), 10001u);
+    EXPECT_EQ(document.get_root()[9999]["id"].as_uint(), 9999u);
+
+    const std::size_t heap_size = document.get_arena().get_heap_size();
+    EXPECT_GT(heap_size, 0u);
+
+    /* Arena memory is reused without growing */
+    document.parsing(str);
+    EXPECT_EQ(document.get_arena().get_heap_size(), heap_size);
+    EXPECT_EQ(document.get_root()[42]["name"].as_string(), "item");
+
+    document.clear();
+    EXPECT_TRUE(document.get_root().is_null());
+}
+
+TEST_F(DocumentTest, PositiveCallerBuffer) {
+    alignas(std::max_align_t) std::array<char, 4096> buffer;
+    Document document(buffer.data(), buffer.size());
+
+    document.parsing(R"({"key": ["value", 1, 2, 3]})");
+    EXPECT_EQ(document.get_arena().get_heap_size(), 0u);
+    EXPECT_EQ(document.get_root()["key"][0].as_string(), "value");
+
+    std::string str{"["};
+    for (unsigned i = 0; i < 1000; ++i) {
+        str += "\"string that doesn't fit in buffer\",";
+    }
+    str += "0]";
+
+    document.parsing(str);
+    EXPECT_GT(document.get_arena().get_heap_size(), 0u);
+    EXPECT_EQ(document.get_root().size(), 1001u);
+}
+
+TEST_F(DocumentTest, PositiveParsingView) {
+    const std::string str{R"({"plain": "text", "escaped\n": "a\"b", "list": ["x", 1]})"};
+    Document document;
+    Document copied;
+
+    document.parsing_view(str);
+    copied.parsing(str);
+
+    const Node& root = document.get_root();
+    EXPECT_EQ(root.to_value(), copied.get_root().to_value());
+
+    /* Strings without escapes reference JSON text */
+    EXPECT_EQ(root.key(0), str.data() + 2);
+    EXPECT_EQ(root.key_length(0), 5u);
+    EXPECT_EQ(root["plain"].as_char(), str.data() + str.find("text"));
+    EXPECT_EQ(root["plain"].length(), 4u);
+    EXPECT_EQ(root["list"][0].as_string(), "x");
+
+    /* Strings with escapes are decoded to arena */
+    EXPECT_EQ(root.key_length(1), 8u);
+    EXPECT_STREQ(root.key(1), "escaped\n");
+    EXPECT_STREQ(root["escaped\n"].as_char(), "a\"b");
+}
+
+TEST_F(DocumentTest, NegativeParsing) {
+    Document document;
+
+    document.parsing("[1, 2]");
+
+    try {
+        document.parsing(R"({"key": [1, 2}})");
+        FAIL();
+    }
+    catch (const DeserializerError& error) {
+        EXPECT_EQ(error.get_code(), DeserializerError::MISS_SQUARE_CLOSE);
+    }
+
+    EXPECT_TRUE(document.get_root().is_null());
+}
+
+TEST_F(DocumentTest, PositiveArenaAlignment) {
+    Arena arena(64);
+
+    for (std::size_t i = 1; i < 1000; ++i) {
+        auto ptr = reinterpret_cast<std::uintptr_t>(arena.allocate(i, 8));
+        EXPECT_EQ(ptr % 8, 0u);
+    }
+
+    void* large = arena.allocate(100000, 16);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(large) % 16, 0u);
+
+    arena.clear();
+    EXPECT_NE(arena.allocate<double>(10), nullptr);
+}
@@ -0,0 +1,163 @@
+/*!
+ * @copyright
+ * Copyright (c) 2015, Tymoteusz Blazejczyk
+ *
+ * @copyright
+ * All rights reserved.
+ *
+ * @copyright
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * @copyright
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * @copyright
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * @copyright
+ * * Neither the name of json-cxx nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * @copyright
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#include "gtest/gtest.h"
+
+#include <string>
+
+#include "json/value.hpp"
+#include "json/handler.hpp"
+#include "json/deserializer.hpp"
+#include "json/deserializer_error.hpp"
+
+using json::Bool;
+using json::Number;
+using json::Handler;
+using json::Deserializer;
+using json::DeserializerError;
+
+class HandlerTest : public ::testing::Test {
+protected:
+    virtual ~HandlerTest();
+};
+
+HandlerTest::~HandlerTest() { }
+
+/*!
+ * @brief Handler that records all events as a compact text
+ * */
+class Recorder : public Handler {
+public:
+    std::string events{};
+
+    void null() override { events += 'n'; }
+
+    void boolean(Bool boolean) override { events += boolean ? 't' : 'f'; }
+
+    void number(const Number& number) override {
+        events += std::to_string(Int64(number));
+    }
+
+    void string(const char* str, std::size_t length) override {
+        events += '"';
+        events.append(str, length);
+        events += '"';
+    }
+
+    void key(const char* str, std::size_t length) override {
+        events.append(str, length);
+        events += ':';
+    }
+
+    void begin_object() override { events += '{'; }
+
+    void end_object() override { events += '}'; }
+
+    void begin_array() override { events += '['; }
+
+    void end_array() override { events += ']'; }
+
+    virtual ~Recorder() override;
+private:
+    using Int64 = json::Int64;
+};
+
+Recorder::~Recorder() { }
+
+/*!
+ * @brief Handler that only counts numbers, ignores all other events
+ * */
+class NumberCounter : public Handler {
+public:
+    std::size_t count{0};
+
+    void number(const Number&) override { ++count; }
+
+    virtual ~NumberCounter() override;
+};
+
+NumberCounter::~NumberCounter() { }
+
+TEST_F(HandlerTest, PositiveEvents) {
+    Recorder recorder;
+
+    ASSERT_NO_THROW(Deserializer().parsing(
+        R"({"a": [1, -2, true, false, null], "b\n": {"c": "x\"y"}, "d": []})",
+        recorder));
+    EXPECT_EQ(recorder.events,
+        "{a:[1-2tfn]b\n:{c:\"x\"y\"}d:[]}");
+}
+
+TEST_F(HandlerTest, PositiveScalar) {
+    Recorder recorder;
+
+    ASSERT_NO_THROW(Deserializer().parsing(" \"text\" ", recorder));
+    EXPECT_EQ(recorder.events, "\"text\"");
+}
+
+TEST_F(HandlerTest, PositiveDefaultEvents) {
+    NumberCounter counter;
+
+    ASSERT_NO_THROW(Deserializer().parsing(
+        R"([{"a": 1, "b": [2, 3]}, "4", 5.5, {}])", counter));
+    EXPECT_EQ(counter.count, 4);
+}
+
+TEST_F(HandlerTest, PositiveLargeArray) {
+    const std::size_t count = 100000;
+    std::string str{"["};
+    NumberCounter counter;
+
+    for (std::size_t i = 0; i < count; ++i) {
+        str += std::to_string(i % 10);
+        str += ',';
+    }
+    str.back() = ']';
+
+    ASSERT_NO_THROW(Deserializer().parsing(str, counter));
+    EXPECT_EQ(counter.count, count);
+}
+
+TEST_F(HandlerTest, NegativeMissingBracket) {
+    Recorder recorder;
+
+    EXPECT_THROW(Deserializer().parsing("[1, 2", recorder), DeserializerError);
+    EXPECT_THROW(Deserializer().parsing(R"({"a" 1})", recorder),
+        DeserializerError);
+}
@@ -0,0 +1,144 @@
+/*!
+ * @copyright
+ * Copyright (c) 2015, Tymoteusz Blazejczyk
+ *
+ * @copyright
+ * All rights reserved.
+ *
+ * @copyright
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * @copyright
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * @copyright
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * @copyright
+ * * Neither the name of json-cxx nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * @copyright
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#include "gtest/gtest.h"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "json/value.hpp"
+#include "json/document.hpp"
+#include "json/iterator.hpp"
+#include "json/key_table.hpp"
+#include "json/deserializer.hpp"
+
+using json::KeyTable;
+using json::Document;
+
+class KeyTableTest : public ::testing::Test {
+protected:
+    virtual ~KeyTableTest();
+};
+
+KeyTableTest::~KeyTableTest() { }
+
+TEST_F(KeyTableTest, PositiveIntern) {
+    KeyTable keys;
+
+    const char* key = keys.intern("key");
+    ASSERT_NE(key, nullptr);
+    EXPECT_STREQ(key, "key");
+    EXPECT_EQ(keys.intern(std::string("key")), key);
+    EXPECT_EQ(keys.intern("key_other", 3), key);
+    EXPECT_NE(keys.intern("other"), key);
+    EXPECT_STREQ(keys.intern(""), "");
+    EXPECT_EQ(keys.size(), 3u);
+}
+
+TEST_F(KeyTableTest, PositiveLimit) {
+    KeyTable keys(16);
+    std::size_t interned = 0;
+
+    /* Limit is for whole table, not for single shard */
+    for (std::size_t i = 0; i < 1000; ++i) {
+        if (nullptr != keys.intern(std::to_string(i))) { ++interned; }
+    }
+
+    EXPECT_EQ(interned, 16u);
+    EXPECT_EQ(keys.size(), 16u);
+    EXPECT_EQ(keys.intern("0"), keys.intern("0"));
+    EXPECT_NE(keys.intern("0"), nullptr);
+}
+
+TEST_F(KeyTableTest, PositiveDocuments) {
+    KeyTable keys;
+    Document first;
+    Document second;
+
+    first.set_key_table(&keys);
+    second.set_key_table(&keys);
+
+    first.parsing(R"([{"id":1,"name":"a"},{"id":2,"name":"b"}])");
+    second.parsing(R"({"name":"c","id":3})");
+
+    const json::Node& root = first.get_root();
+    EXPECT_EQ(root[0].key(0), root[1].key(0));
+    EXPECT_EQ(root[0].key(1), second.get_root().key(0));
+    EXPECT_EQ(root[1].key(1), keys.intern("name"));
+    EXPECT_EQ(root[1][keys.intern("id")].as_int(), 2);
+    EXPECT_EQ(second.get_root()["id"].as_int(), 3);
+    EXPECT_EQ(keys.size(), 2u);
+    EXPECT_EQ(first.get_root().to_value(), json::Deserializer(
+                R"([{"id":1,"name":"a"},{"id":2,"name":"b"}])").get_value());
+}
+
+TEST_F(KeyTableTest, PositiveDocumentTableFull) {
+    KeyTable keys(1);
+    Document document;
+
+    document.set_key_table(&keys);
+    document.parsing(R"({"a":1,"b":2,"c":3,"a\"":4})");
+
+    EXPECT_EQ(document.get_root()["a"].as_int(), 1);
+    EXPECT_EQ(document.get_root()["b"].as_int(), 2);
+    EXPECT_EQ(document.get_root()["c"].as_int(), 3);
+    EXPECT_EQ(document.get_root()["a\""].as_int(), 4);
+}
+
+TEST_F(KeyTableTest, PositiveThreads) {
+    KeyTable keys;
+    std::vector<std::thread> threads;
+    std::vector<std::vector<const char*>> interned(4);
+
+    for (std::size_t i = 0; i < interned.size(); ++i) {
+        threads.emplace_back([&keys, &interned, i] {
+            for (std::size_t j = 0; j < 500; ++j) {
+                interned[i].push_back(keys.intern(std::to_string(j)));
+            }
+        });
+    }
+
+    for (auto& thread : threads) { thread.join(); }
+
+    EXPECT_EQ(keys.size(), 500u);
+    for (const auto& pointers : interned) {
+        EXPECT_EQ(pointers, interned.front());
+    }
+}
@@ -0,0 +1,204 @@
+/*!
+ * @copyright
+ * Copyright (c) 2015, Tymoteusz Blazejczyk
+ *
+ * @copyright
+ * All rights reserved.
+ *
+ * @copyright
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * @copyright
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * @copyright
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * @copyright
+ * * Neither the name of json-cxx nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * @copyright
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#include "gtest/gtest.h"
+
+#include <mutex>
+#include <string>
+#include <vector>
+#include <cstdio>
+
+#include "json/value.hpp"
+#include "json/iterator.hpp"
+#include "json/lines_deserializer.hpp"
+#include "json/deserializer_error.hpp"
+
+using json::Value;
+using json::LinesDeserializer;
+using json::DeserializerError;
+
+class LinesDeserializerTest : public ::testing::Test {
+protected:
+    virtual ~LinesDeserializerTest();
+};
+
+LinesDeserializerTest::~LinesDeserializerTest() { }
+
+static std::string make_lines(std::size_t count) {
+    std::string str;
+
+    for (std::size_t i = 0; i < count; ++i) {
+        str += R"({"id":)" + std::to_string(i) + R"(,"tags":["a","b"]})";
+        str += (0 == (i % 7)) ? "\r\n\n" : "\n";
+    }
+
+    return str;
+}
+
+TEST_F(LinesDeserializerTest, PositiveOrdered) {
+    const std::size_t count = 1000;
+    std::vector<Value> values;
+
+    ASSERT_NO_THROW(LinesDeserializer(4).parsing(make_lines(count), values));
+    ASSERT_EQ(values.size(), count);
+    for (std::size_t i = 0; i < count; ++i) {
+        EXPECT_EQ(values[i]["id"], int(i));
+        EXPECT_EQ(values[i]["tags"].size(), 2);
+    }
+}
+
+TEST_F(LinesDeserializerTest, PositiveLastLineWithoutNewline) {
+    std::vector<Value> values;
+
+    ASSERT_NO_THROW(LinesDeserializer(2).parsing("  \n[1]\n\n 2\n\"x\"",
+                values));
+    ASSERT_EQ(values.size(), 3);
+    EXPECT_EQ(values[0][0], 1);
+    EXPECT_EQ(values[1], 2);
+    EXPECT_EQ(values[2], "x");
+}
+
+TEST_F(LinesDeserializerTest, PositiveUnordered) {
+    const std::size_t count = 1000;
+    std::vector<bool> seen(count, false);
+    std::mutex mutex;
+
+    ASSERT_NO_THROW(LinesDeserializer(4).parsing(make_lines(count),
+        [&](std::size_t index, Value& value) {
+            std::lock_guard<std::mutex> lock(mutex);
+            EXPECT_EQ(value["id"], int(index));
+            seen[index] = true;
+        }));
+
+    for (std::size_t i = 0; i < count; ++i) {
+        EXPECT_TRUE(seen[i]);
+    }
+}
+
+TEST_F(LinesDeserializerTest, PositiveFile) {
+    const std::size_t count = 1000;
+    const std::string str = make_lines(count);
+    std::FILE* file = std::tmpfile();
+    LinesDeserializer deserializer(3);
+    std::vector<Value> values;
+
+    ASSERT_NE(file, nullptr);
+    std::fwrite(str.data(), 1, str.size(), file);
+    std::rewind(file);
+
+    deserializer.set_block_size(100);
+    ASSERT_NO_THROW(deserializer.parsing(file, values));
+    std::fclose(file);
+
+    ASSERT_EQ(values.size(), count);
+    for (std::size_t i = 0; i < count; ++i) {
+        EXPECT_EQ(values[i]["id"], int(i));
+    }
+}
+
+TEST_F(LinesDeserializerTest, NegativeInvalidRecord) {
+    std::string str = make_lines(100);
+    std::vector<Value> values;
+    const std::size_t offset = str.size() + 3;
+
+    str += "[1,}\n";
+    str += make_lines(100);
+
+    try {
+        LinesDeserializer(4).parsing(str, values);
+        FAIL();
+    }
+    catch (const DeserializerError& error) {
+        EXPECT_EQ(error.get_code(), DeserializerError::MISS_VALUE);
+        EXPECT_EQ(error.get_offset(), offset);
+    }
+}
+
+TEST_F(LinesDeserializerTest, PositiveFileUnordered) {
+    const std::size_t count = 1000;
+    const std::string str = make_lines(count);
+    std::FILE* file = std::tmpfile();
+    LinesDeserializer deserializer(4);
+    std::vector<bool> seen(count, false);
+    std::mutex mutex;
+
+    ASSERT_NE(file, nullptr);
+    std::fwrite(str.data(), 1, str.size(), file);
+    std::rewind(file);
+
+    deserializer.set_block_size(0);
+    ASSERT_NO_THROW(deserializer.parsing(file,
+        [&](std::size_t index, Value& value) {
+            std::lock_guard<std::mutex> lock(mutex);
+            EXPECT_EQ(value["id"], int(index));
+            seen[index] = true;
+        }));
+    std::fclose(file);
+
+    for (std::size_t i = 0; i < count; ++i) {
+        EXPECT_TRUE(seen[i]);
+    }
+}
+
+TEST_F(LinesDeserializerTest, NegativeInvalidRecordFile) {
+    std::string str = make_lines(100);
+    const std::size_t offset = str.size() + 3;
+    std::FILE* file = std::tmpfile();
+    LinesDeserializer deserializer(3);
+    std::vector<Value> values;
+
+    str += "[1,}\n";
+    str += make_lines(100);
+
+    ASSERT_NE(file, nullptr);
+    std::fwrite(str.data(), 1, str.size(), file);
+    std::rewind(file);
+
+    deserializer.set_block_size(64);
+
+    try {
+        deserializer.parsing(file, values);
+        FAIL();
+    }
+    catch (const DeserializerError& error) {
+        EXPECT_EQ(error.get_code(), DeserializerError::MISS_VALUE);
+        EXPECT_EQ(error.get_offset(), offset);
+    }
+    std::fclose(file);
+}
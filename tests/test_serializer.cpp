@@ -0,0 +1,426 @@
+/*!
+ * @copyright
+ * Copyright (c) 2015, Tymoteusz Blazejczyk
+ *
+ * @copyright
+ * All rights reserved.
+ *
+ * @copyright
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * @copyright
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * @copyright
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * @copyright
+ * * Neither the name of json-cxx nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * @copyright
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#include "gtest/gtest.h"
+
+#include <random>
+#include <cmath>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <sstream>
+#include <system_error>
+#include <cstdio>
+#include <vector>
+#include <string>
+
+#include "json/value.hpp"
+#include "json/serializer.hpp"
+#include "json/deserializer.hpp"
+#include "json/formatter/pretty.hpp"
+#include "json/formatter/compact.hpp"
+#include "json/writter/string.hpp"
+#include "json/writter/file.hpp"
+#include "json/writter/fd.hpp"
+#include "json/writter/ostream.hpp"
+
+#include <unistd.h>
+#include <sys/stat.h>
+
+using json::Value;
+using json::Serializer;
+
+class SerializerTest : public ::testing::Test {
+protected:
+    virtual ~SerializerTest();
+};
+
+SerializerTest::~SerializerTest() { }
+
+static std::string serialize(const Value& value) {
+    return Serializer{value}.read();
+}
+
+TEST_F(SerializerTest, PositiveDoubleShortest) {
+    const std::vector<std::pair<json::Double, std::string>> tests{
+        {0.0, "0.0"},
+        {-0.0, "-0.0"},
+        {1.0, "1.0"},
+        {-2.5, "-2.5"},
+        {0.1, "0.1"},
+        {3.17, "3.17"},
+        {100000000000000.0, "100000000000000.0"},
+        {1e15, "1e+15"},
+        {0.0001, "0.0001"},
+        {0.00001, "1e-5"},
+        {1e22, "1e+22"},
+        {123456.789e300, "1.23456789e+305"},
+        {5e-324, "5e-324"},
+        {2.2250738585072014e-308, "2.2250738585072014e-308"},
+        {1.7976931348623157e308, "1.7976931348623157e+308"},
+        /* Grisu2 is not always the shortest, but it round-trips */
+        {1e23, "9.999999999999999e+22"},
+        {54057274422453184.0, "5.4057274422453184e+16"}
+    };
+
+    for (const auto& test : tests) {
+        EXPECT_EQ(serialize(Value(test.first)), test.second);
+    }
+}
+
+TEST_F(SerializerTest, PositiveDoubleNotFinite) {
+    EXPECT_EQ(serialize(Value(std::numeric_limits<json::Double>::quiet_NaN())),
+            "null");
+    EXPECT_EQ(serialize(Value(std::numeric_limits<json::Double>::infinity())),
+            "null");
+    EXPECT_EQ(serialize(Value(-std::numeric_limits<json::Double>::infinity())),
+            "null");
+}
+
+TEST_F(SerializerTest, PositiveDoubleRoundTrip) {
+    std::mt19937_64 generator(0);
+
+    for (int i = 0; i < 10000; ++i) {
+        json::Uint64 bits = generator();
+        json::Double number;
+
+        std::memcpy(&number, &bits, sizeof(number));
+        if (!std::isfinite(number)) { continue; }
+
+        std::string str = serialize(Value(number));
+        EXPECT_EQ(std::strtod(str.c_str(), nullptr), number) << str;
+    }
+}
+
+TEST_F(SerializerTest, PositiveIntegerLimits) {
+    const std::string str{"[0,1,9,10,99,100,999,1000,4294967295,4294967296,"
+        "9999999999999999999,10000000000000000000,18446744073709551615,"
+        "-1,-9,-10,-2147483648,-2147483649,-9223372036854775808]"};
+    Value value;
+
+    ASSERT_NO_THROW(str >> value);
+    EXPECT_EQ(serialize(value), str);
+}
+
+TEST_F(SerializerTest, PositiveIntegerRoundTrip) {
+    std::mt19937_64 generator(0);
+
+    for (int i = 0; i < 10000; ++i) {
+        /* Random magnitude to cover all digit counts */
+        json::Uint64 number = generator() >> (generator() % 64);
+        std::string expected = std::to_string(number);
+        if (0 != (i % 2)) {
+            expected = std::to_string(-json::Int64(number >> 1));
+        }
+
+        Value value;
+        ASSERT_NO_THROW(expected >> value);
+        EXPECT_EQ(serialize(value), expected);
+    }
+}
+
+TEST_F(SerializerTest, PositiveLargeOutput) {
+    const std::string str(3 * json::Formatter::BUFFER_SIZE, 'x');
+    std::string expected{"[\"" + str + "\""};
+
+    for (unsigned i = 0; i < 10000; ++i) {
+        expected += "," + std::to_string(i);
+    }
+    expected += "]";
+
+    Value value;
+    ASSERT_NO_THROW(expected >> value);
+    EXPECT_EQ(serialize(value), expected);
+}
+
+TEST_F(SerializerTest, PositivePretty) {
+    Value value;
+    json::formatter::Pretty pretty;
+
+    ASSERT_NO_THROW(R"({"key":[1,"a\"b"],"empty":{}})" >> value);
+    EXPECT_EQ((Serializer{value, &pretty}.read()),
+            "{\n"
+            "    \"key\" : [\n"
+            "        1,\n"
+            "        \"a\\\"b\"\n"
+            "    ],\n"
+            "    \"empty\" : {}\n"
+            "}");
+}
+
+TEST_F(SerializerTest, PositiveStringEscape) {
+    const std::vector<std::pair<std::string, std::string>> tests{
+        {"", R"("")"},
+        {"text", R"("text")"},
+        {"a\"b\\c", R"("a\"b\\c")"},
+        {"\b\f\n\r\t", R"("\b\f\n\r\t")"},
+        {std::string("\0\x01\x1F\x7F", 4), "\"\\u0000\\u0001\\u001F\x7F\""},
+        {"é€😀", "\"é€😀\""}
+    };
+
+    for (const auto& test : tests) {
+        EXPECT_EQ(serialize(Value(test.first)), test.second);
+    }
+}
+
+TEST_F(SerializerTest, PositiveStringEscapeUnicode) {
+    const std::vector<std::pair<std::string, std::string>> tests{
+        {"text\n", R"("text\n")"},
+        {"\xC3\xA9", R"("\u00E9")"},
+        {"a\xE2\x82\xAC" "b", R"("a\u20ACb")"},
+        {"\xF0\x9F\x98\x80", R"("\uD83D\uDE00")"},
+        {"\xC3", R"("\uFFFD")"},
+        {"\xC0\xAF!", R"("\uFFFD\uFFFD!")"},
+        {"\xED\xA0\x80", R"("\uFFFD\uFFFD\uFFFD")"}
+    };
+    json::formatter::Compact compact;
+    compact.set_escape_unicode(true);
+
+    for (const auto& test : tests) {
+        EXPECT_EQ((Serializer{Value(test.first), &compact}.read()),
+                test.second);
+    }
+}
+
+TEST_F(SerializerTest, PositiveStringEscapeRoundTrip) {
+    std::string str;
+    for (std::size_t i = 0; i < 200; ++i) {
+        str += std::string(i % 37, 'x');
+        str += char(i % 0x24);
+        str += (0 == (i % 3)) ? "\"" : "\\";
+        str += "é😀";
+    }
+
+    for (bool escape_unicode : {false, true}) {
+        json::formatter::Compact compact;
+        compact.set_escape_unicode(escape_unicode);
+
+        Value value;
+        ASSERT_NO_THROW((Serializer{Value(str), &compact}.read()) >> value);
+        EXPECT_EQ(value.as_string(), str);
+    }
+}
+
+TEST_F(SerializerTest, PositiveExactSize) {
+    std::string expected{"["};
+
+    for (unsigned i = 0; i < 10000; ++i) {
+        expected += "{\"id\":" + std::to_string(i) + ",\"x\":0.5},";
+    }
+    expected += "null]";
+
+    Value value;
+    ASSERT_NO_THROW(expected >> value);
+
+    Serializer serializer;
+    serializer.set_exact_size(true);
+    EXPECT_TRUE(serializer.is_exact_size());
+
+    serializer << value;
+    EXPECT_EQ(serializer.read(), expected);
+
+    json::formatter::Pretty pretty;
+    Serializer pretty_serializer(&pretty);
+    pretty_serializer.set_exact_size(true);
+
+    pretty_serializer << value;
+    EXPECT_EQ(pretty_serializer.read(), (Serializer{value, &pretty}.read()));
+}
+
+static Value streaming_value() {
+    std::string str{"["};
+
+    for (unsigned i = 0; i < 5000; ++i) {
+        str += "{\"id\":" + std::to_string(i) + ",\"name\":\"item\"},";
+    }
+    str += "null]";
+
+    Value value;
+    str >> value;
+    return value;
+}
+
+static std::string read_file(std::FILE* file) {
+    std::string str;
+    char buffer[1024];
+    std::size_t length;
+
+    std::rewind(file);
+    while ((length = std::fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        str.append(buffer, length);
+    }
+    return str;
+}
+
+/*! Formatter that writes numbers directly to writter, bypassing buffer */
+class DirectFormatter : public json::formatter::Compact {
+public:
+    DirectFormatter(json::Writter* writter) : Compact(writter) { }
+protected:
+    virtual void write_number(const json::Number&) override {
+        get_direct_writter()->write("<n>");
+    }
+};
+
+TEST_F(SerializerTest, PositiveFormatterDirectWrite) {
+    json::writter::String writter;
+    DirectFormatter formatter(&writter);
+
+    formatter.formatting(Value{"a", 1, Value{2, "b"}, 3});
+    EXPECT_EQ(writter.read(), "[\"a\",<n>,[<n>,\"b\"],<n>]");
+}
+
+TEST_F(SerializerTest, PositiveStreamOstream) {
+    Value value = streaming_value();
+    std::ostringstream os;
+
+    {
+        json::writter::Ostream writter(os, 100);
+        Serializer().write(value, writter);
+    }
+    EXPECT_EQ(os.str(), serialize(value));
+
+    std::ostringstream os_operator;
+    os_operator << value;
+    EXPECT_EQ(os_operator.str(), serialize(value));
+}
+
+/*! Stream buffer that counts flushes of output stream */
+class SyncCounter : public std::stringbuf {
+public:
+    std::size_t syncs{0};
+protected:
+    virtual int sync() override {
+        ++syncs;
+        return std::stringbuf::sync();
+    }
+};
+
+TEST_F(SerializerTest, PositiveStreamOstreamChain) {
+    SyncCounter buffer;
+    std::ostream os(&buffer);
+    std::string expected;
+
+    for (int i = 0; i < 100; ++i) {
+        Value value{i, "str", nullptr};
+        os << value << value;
+        expected += serialize(value) + serialize(value);
+    }
+
+    EXPECT_EQ(buffer.str(), expected);
+    EXPECT_EQ(0u, buffer.syncs);
+}
+
+TEST_F(SerializerTest, PositiveStreamFile) {
+    Value value = streaming_value();
+    std::FILE* file = std::tmpfile();
+    ASSERT_NE(file, nullptr);
+
+    json::formatter::Pretty pretty;
+    {
+        json::writter::File writter(file, 100);
+        Serializer(&pretty).write(value, writter);
+
+        /* Data must reach file descriptor before writter is destroyed */
+        struct stat info;
+        ASSERT_EQ(0, fstat(fileno(file), &info));
+        EXPECT_EQ(std::size_t(info.st_size),
+                (Serializer{value, &pretty}.read().size()));
+    }
+    EXPECT_EQ(read_file(file), (Serializer{value, &pretty}.read()));
+
+    std::fclose(file);
+}
+
+TEST_F(SerializerTest, PositiveStreamFd) {
+    Value value = streaming_value();
+    std::FILE* file = std::tmpfile();
+    ASSERT_NE(file, nullptr);
+
+    {
+        json::writter::Fd writter(fileno(file), 100);
+        Serializer().write(value, writter);
+    }
+    EXPECT_EQ(read_file(file), serialize(value));
+
+    std::fclose(file);
+}
+
+TEST_F(SerializerTest, NegativeStreamOstream) {
+    std::ostringstream os;
+    json::writter::Ostream writter(os);
+
+    os.setstate(std::ios::badbit);
+    writter.write("[]");
+    EXPECT_THROW(writter.flush(), std::system_error);
+}
+
+TEST_F(SerializerTest, NegativeStreamFd) {
+    json::writter::Fd writter(-1);
+
+    writter.write("[]");
+    EXPECT_THROW(writter.flush(), std::system_error);
+}
+
+/*! Writter that fails on every write */
+class FailingWritter : public json::writter::String {
+public:
+    using String::write;
+
+    virtual void write(const char*, std::size_t) override {
+        throw std::system_error(EIO, std::generic_category());
+    }
+};
+
+TEST_F(SerializerTest, NegativeStreamWritterReplaced) {
+    Value value = streaming_value();
+    json::formatter::Compact formatter;
+    Serializer serializer(&formatter);
+
+    {
+        FailingWritter* failing = new FailingWritter;
+        EXPECT_THROW(serializer.write(value, *failing), std::system_error);
+        delete failing;
+    }
+
+    json::writter::String writter;
+    serializer.write(value, writter);
+    EXPECT_EQ(writter.read(), serialize(value));
+}
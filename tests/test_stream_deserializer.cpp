@@ -0,0 +1,260 @@
+/*!
+ * @copyright
+ * Copyright (c) 2015, Tymoteusz Blazejczyk
+ *
+ * @copyright
+ * All rights reserved.
+ *
+ * @copyright
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * @copyright
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * @copyright
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * @copyright
+ * * Neither the name of json-cxx nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * @copyright
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#include "gtest/gtest.h"
+
+#include <string>
+
+#include "json/value.hpp"
+#include "json/iterator.hpp"
+#include "json/handler.hpp"
+#include "json/deserializer.hpp"
+#include "json/stream_deserializer.hpp"
+#include "json/deserializer_error.hpp"
+
+using json::Value;
+using json::Number;
+using json::Handler;
+using json::Deserializer;
+using json::StreamDeserializer;
+using json::DeserializerError;
+
+class StreamDeserializerTest : public ::testing::Test {
+protected:
+    virtual ~StreamDeserializerTest();
+};
+
+StreamDeserializerTest::~StreamDeserializerTest() { }
+
+static const char* const TEST_JSON = R"({
+    "string": "text \"quoted\" é 😀",
+    "numbers": [0, -1, 2147483647, 3.5, 1e-3, -2.5E+10],
+    "literals": [true, false, null],
+    "nested": {"empty_object": {}, "empty_array": [], "array": [[1], [2]]},
+    "last": "value"
+} )";
+
+/*!
+ * @brief Handler that counts all events
+ * */
+class Counter : public Handler {
+public:
+    std::size_t count{0};
+
+    void null() override { ++count; }
+
+    void boolean(json::Bool) override { ++count; }
+
+    void number(const Number&) override { ++count; }
+
+    void string(const char*, std::size_t) override { ++count; }
+
+    void key(const char*, std::size_t) override { ++count; }
+
+    void begin_object() override { ++count; }
+
+    void end_object() override { ++count; }
+
+    void begin_array() override { ++count; }
+
+    void end_array() override { ++count; }
+
+    virtual ~Counter() override;
+};
+
+Counter::~Counter() { }
+
+TEST_F(StreamDeserializerTest, PositiveSingleChunk) {
+    StreamDeserializer deserializer;
+
+    EXPECT_TRUE(deserializer.parsing(TEST_JSON));
+    EXPECT_TRUE(deserializer.is_complete());
+    EXPECT_EQ(deserializer.get_value(),
+            Deserializer(TEST_JSON).get_value());
+}
+
+TEST_F(StreamDeserializerTest, PositiveEverySplit) {
+    const std::string str{TEST_JSON};
+    const Value expected = Deserializer(str).get_value();
+    const std::size_t end = str.rfind('}');
+
+    for (std::size_t i = 0; i <= str.size(); ++i) {
+        StreamDeserializer deserializer;
+
+        EXPECT_EQ(deserializer.parsing(str.data(), i), i > end);
+        EXPECT_TRUE(deserializer.parsing(str.data() + i, str.size() - i));
+        EXPECT_EQ(deserializer.get_value(), expected) << "split at " << i;
+    }
+}
+
+TEST_F(StreamDeserializerTest, PositiveEveryTokenSplit) {
+    const std::string str{
+        R"([" \\\" \\", "\u0041\\", -12.5e+3, true, null, 1E2, "x"])"};
+    const Value expected = Deserializer(str).get_value();
+
+    for (std::size_t i = 0; i <= str.size(); ++i) {
+        for (std::size_t j = i; j <= str.size(); ++j) {
+            StreamDeserializer deserializer;
+
+            deserializer.parsing(str.data(), i);
+            deserializer.parsing(str.data() + i, j - i);
+            EXPECT_TRUE(deserializer.parsing(str.data() + j, str.size() - j));
+            EXPECT_EQ(deserializer.get_value(), expected)
+                << "split at " << i << " and " << j;
+        }
+    }
+}
+
+TEST_F(StreamDeserializerTest, PositiveSingleCharacters) {
+    const std::string str{TEST_JSON};
+    StreamDeserializer deserializer;
+
+    for (const char& ch : str) {
+        deserializer.parsing(&ch, 1);
+    }
+    deserializer.finish();
+
+    EXPECT_TRUE(deserializer.is_complete());
+    EXPECT_EQ(deserializer.release(), Deserializer(str).get_value());
+    EXPECT_EQ(deserializer.get_value(), nullptr);
+}
+
+TEST_F(StreamDeserializerTest, PositiveNumberNeedsFinish) {
+    StreamDeserializer deserializer;
+
+    EXPECT_FALSE(deserializer.parsing("12"));
+    EXPECT_FALSE(deserializer.parsing("34.5"));
+    deserializer.finish();
+    EXPECT_TRUE(deserializer.is_complete());
+    EXPECT_EQ(deserializer.get_value(), 1234.5);
+}
+
+TEST_F(StreamDeserializerTest, PositiveTrailingWhitespaces) {
+    StreamDeserializer deserializer;
+
+    EXPECT_TRUE(deserializer.parsing("[1, 2]"));
+    EXPECT_TRUE(deserializer.parsing(" \n"));
+    deserializer.finish();
+    EXPECT_EQ(deserializer.get_value().size(), 2);
+}
+
+TEST_F(StreamDeserializerTest, PositiveHandler) {
+    const std::string str{TEST_JSON};
+    Counter expected;
+    Counter counter;
+    StreamDeserializer deserializer(counter);
+
+    Deserializer().parsing(str, expected);
+
+    for (const char& ch : str) {
+        deserializer.parsing(&ch, 1);
+    }
+    deserializer.finish();
+
+    EXPECT_TRUE(deserializer.is_complete());
+    EXPECT_EQ(counter.count, expected.count);
+    EXPECT_EQ(deserializer.get_value(), nullptr);
+}
+
+TEST_F(StreamDeserializerTest, PositiveClear) {
+    StreamDeserializer deserializer;
+
+    EXPECT_TRUE(deserializer.parsing("[1]"));
+    deserializer.clear();
+    EXPECT_FALSE(deserializer.is_complete());
+    EXPECT_TRUE(deserializer.parsing(R"({"key":true})"));
+    EXPECT_EQ(deserializer.get_value()["key"], true);
+}
+
+TEST_F(StreamDeserializerTest, NegativeIncomplete) {
+    StreamDeserializer deserializer;
+
+    EXPECT_FALSE(deserializer.parsing(R"({"key": [1, 2)"));
+
+    try {
+        deserializer.finish();
+        FAIL();
+    }
+    catch (const DeserializerError& error) {
+        EXPECT_EQ(error.get_code(), DeserializerError::END_OF_FILE);
+        EXPECT_EQ(error.get_offset(), 13);
+    }
+}
+
+TEST_F(StreamDeserializerTest, NegativeInvalidToken) {
+    StreamDeserializer deserializer;
+
+    EXPECT_FALSE(deserializer.parsing("[1, 2"));
+
+    try {
+        deserializer.parsing(" }");
+        FAIL();
+    }
+    catch (const DeserializerError& error) {
+        EXPECT_EQ(error.get_code(), DeserializerError::MISS_SQUARE_CLOSE);
+        EXPECT_EQ(error.get_offset(), 6);
+    }
+}
+
+TEST_F(StreamDeserializerTest, NegativeInvalidTokenOffset) {
+    const std::string str{R"(["a\"b", 12.5, tru])"};
+
+    for (std::size_t i = 0; i <= str.size(); ++i) {
+        StreamDeserializer deserializer;
+
+        try {
+            deserializer.parsing(str.data(), i);
+            deserializer.parsing(str.data() + i, str.size() - i);
+            deserializer.finish();
+            FAIL() << "split at " << i;
+        }
+        catch (const DeserializerError& error) {
+            EXPECT_EQ(error.get_code(), DeserializerError::NOT_MATCH_TRUE)
+                << "split at " << i;
+            EXPECT_EQ(error.get_offset(), 15) << "split at " << i;
+        }
+    }
+}
+
+TEST_F(StreamDeserializerTest, NegativeAfterDocument) {
+    StreamDeserializer deserializer;
+
+    EXPECT_TRUE(deserializer.parsing("[]"));
+    EXPECT_THROW(deserializer.parsing(" x"), DeserializerError);
+}
@@ -0,0 +1,226 @@
+/*!
+ * @copyright
+ * Copyright (c) 2015, Tymoteusz Blazejczyk
+ *
+ * @copyright
+ * All rights reserved.
+ *
+ * @copyright
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * @copyright
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * @copyright
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * @copyright
+ * * Neither the name of json-cxx nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * @copyright
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#include "gtest/gtest.h"
+
+#include <string>
+
+#include "json/value.hpp"
+#include "json/tape.hpp"
+#include "json/iterator.hpp"
+#include "json/deserializer.hpp"
+#include "json/deserializer_error.hpp"
+#include "json/value_error.hpp"
+
+using json::Value;
+using json::Tape;
+using json::TapeView;
+using json::Deserializer;
+using json::DeserializerError;
+
+class TapeTest : public ::testing::Test {
+protected:
+    virtual ~TapeTest();
+};
+
+TapeTest::~TapeTest() { }
+
+static const char* const TEST_JSON = R"({
+    "string": "text \"quoted\" é",
+    "numbers": [0, -1, 2147483647, 3.5, 1e-3, 4294967295],
+    "literals": [true, false, null],
+    "nested": {"empty_object": {}, "empty_array": [], "array": [[1], [2]]},
+    "last": "value"
+})";
+
+TEST_F(TapeTest, PositiveAccess) {
+    Tape tape;
+    tape.parsing(TEST_JSON);
+    const TapeView root = tape.get_root();
+
+    ASSERT_TRUE(root.is_object());
+    EXPECT_EQ(root.size(), 5u);
+    EXPECT_EQ(root["string"].as_string(), "text \"quoted\" é");
+    EXPECT_EQ(root["string"].length(), std::strlen("text \"quoted\" é"));
+    EXPECT_EQ(root["numbers"].size(), 6u);
+    EXPECT_EQ(root["numbers"][1].as_int(), -1);
+    EXPECT_EQ(root["numbers"][2].as_int(), 2147483647);
+    EXPECT_DOUBLE_EQ(root["numbers"][3].as_double(), 3.5);
+    EXPECT_EQ(root["numbers"][5].as_uint64(), 4294967295u);
+    EXPECT_TRUE(root["literals"][0].as_bool());
+    EXPECT_FALSE(root["literals"][1].as_bool());
+    EXPECT_TRUE(root["literals"][2].is_null());
+    EXPECT_TRUE(root["literals"][2].is_valid());
+    EXPECT_TRUE(root["nested"]["empty_object"].empty());
+    EXPECT_TRUE(root["nested"]["empty_array"].is_array());
+    EXPECT_EQ(root["nested"]["array"][1][0].as_uint(), 2u);
+    EXPECT_EQ(root["last"].as_string(), "value");
+    EXPECT_EQ(root[4].as_string(), "value");
+}
+
+TEST_F(TapeTest, PositiveMissing) {
+    Tape tape;
+    tape.parsing(TEST_JSON);
+    const TapeView root = tape.get_root();
+
+    EXPECT_FALSE(root["missing"].is_valid());
+    EXPECT_TRUE(root["missing"].is_null());
+    EXPECT_FALSE(root.is_member("missing"));
+    EXPECT_TRUE(root.is_member("nested"));
+    EXPECT_FALSE(root["numbers"][6].is_valid());
+    EXPECT_FALSE(root["string"]["key"].is_valid());
+    EXPECT_FALSE(root["missing"]["key"][0].is_valid());
+}
+
+TEST_F(TapeTest, PositiveIteration) {
+    Tape tape;
+    tape.parsing(TEST_JSON);
+    const TapeView root = tape.get_root();
+
+    std::string keys;
+    for (auto it = root.begin(); it != root.end(); ++it) {
+        keys += it.key();
+        keys += ',';
+    }
+    EXPECT_EQ(keys, "string,numbers,literals,nested,last,");
+
+    int sum = 0;
+    for (const auto& element : root["nested"]["array"]) {
+        sum += element[0].as_int();
+    }
+    EXPECT_EQ(sum, 3);
+
+    EXPECT_TRUE(root["nested"]["empty_array"].begin()
+            == root["nested"]["empty_array"].end());
+}
+
+TEST_F(TapeTest, PositiveToValue) {
+    Tape tape;
+    tape.parsing(TEST_JSON);
+
+    EXPECT_EQ(tape.get_root().to_value(), Deserializer(TEST_JSON).get_value());
+
+    tape.set_structural_index(true);
+    tape.parsing(TEST_JSON);
+
+    EXPECT_EQ(tape.get_root().to_value(), Deserializer(TEST_JSON).get_value());
+}
+
+TEST_F(TapeTest, PositiveToValueKeys) {
+    const std::string str{R"({"a": 1, "b\u0000c": {"d": 2, "d": [3]}, "a": "4"})"};
+    Tape tape;
+    tape.parsing(str);
+
+    const Value value = tape.get_root().to_value();
+    ASSERT_EQ(value.size(), 3u);
+    EXPECT_EQ(value.as_object()[1].first, std::string("b\0c", 3));
+    EXPECT_EQ(value[std::size_t(1)].size(), 2u);
+    EXPECT_EQ(value[std::size_t(2)], Value("4"));
+    EXPECT_EQ(value, Deserializer(str).get_value());
+}
+
+TEST_F(TapeTest, PositiveToValueDeepNesting) {
+    const unsigned depth = 1000;
+    std::string str;
+
+    for (unsigned i = 0; i < depth; ++i) { str += "{\"k\":[1,"; }
+    str += "2";
+    for (unsigned i = 0; i < depth; ++i) { str += "]}"; }
+
+    Tape tape;
+    tape.parsing(str);
+
+    EXPECT_EQ(tape.get_root().to_value(), Deserializer(str).get_value());
+}
+
+TEST_F(TapeTest, PositiveScalar) {
+    Tape tape;
+
+    tape.parsing(" \"text\" ");
+    EXPECT_EQ(tape.get_root().as_string(), "text");
+    EXPECT_EQ(tape.get_words_size(), 1u);
+
+    tape.parsing("-5");
+    EXPECT_EQ(tape.get_root().as_int(), -5);
+    EXPECT_EQ(tape.get_words_size(), 2u);
+    EXPECT_EQ(tape.get_strings_size(), 0u);
+
+    tape.parsing("18446744073709551615");
+    EXPECT_EQ(tape.get_root().as_uint64(), 18446744073709551615u);
+}
+
+TEST_F(TapeTest, NegativeTypes) {
+    Tape tape;
+    tape.parsing(TEST_JSON);
+    const TapeView root = tape.get_root();
+
+    EXPECT_THROW(root["numbers"].as_string(), json::ValueError);
+    EXPECT_THROW(root["string"].as_number(), json::ValueError);
+    EXPECT_THROW(root["string"].as_bool(), json::ValueError);
+}
+
+TEST_F(TapeTest, NegativeParsing) {
+    Tape tape;
+
+    EXPECT_THROW(tape.parsing(R"({"key": [1, 2})"), DeserializerError);
+    EXPECT_TRUE(tape.get_root().is_null());
+    EXPECT_EQ(tape.get_words_size(), 0u);
+}
+
+TEST_F(TapeTest, NegativeWordsLimit) {
+    Tape tape;
+
+    /* Array begin, two numbers with value words and array end */
+    tape.set_words_limit(6);
+    tape.parsing("[1, 2]");
+    EXPECT_EQ(tape.get_words_size(), 6u);
+
+    tape.set_words_limit(5);
+    try {
+        tape.parsing("[1, 2]");
+        FAIL() << "Tape limit not checked";
+    }
+    catch (const DeserializerError& error) {
+        EXPECT_EQ(error.get_code(), DeserializerError::TAPE_LIMIT_REACHED);
+    }
+    EXPECT_TRUE(tape.get_root().is_null());
+
+    tape.set_structural_index(true);
+    EXPECT_THROW(tape.parsing("[[1], 2]"), DeserializerError);
+}
@@ -0,0 +1,344 @@
+/*!
+ * @copyright
+ * Copyright (c) 2015, Tymoteusz Blazejczyk
+ *
+ * @copyright
+ * All rights reserved.
+ *
+ * @copyright
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * @copyright
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * @copyright
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * @copyright
+ * * Neither the name of json-cxx nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * @copyright
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#include "gtest/gtest.h"
+
+#include <string>
+
+#include "json/value.hpp"
+#include "json/iterator.hpp"
+#include "json/deserializer.hpp"
+
+using json::Value;
+
+class ValueTest : public ::testing::Test {
+protected:
+    virtual ~ValueTest();
+};
+
+ValueTest::~ValueTest() { }
+
+static std::string key(unsigned i) {
+    return "key" + std::to_string(i);
+}
+
+TEST_F(ValueTest, PositiveMembersLookup) {
+    const unsigned count = 1000;
+    Value value;
+
+    for (unsigned i = 0; i < count; ++i) {
+        value[key(i)] = i;
+    }
+
+    ASSERT_EQ(value.size(), count);
+
+    const Value& cvalue = value;
+    for (unsigned i = 0; i < count; ++i) {
+        EXPECT_TRUE(value.is_member(key(i)));
+        EXPECT_EQ(cvalue[key(i)].as_uint(), i);
+        EXPECT_EQ(value[std::size_t(i)].as_uint(), i);
+    }
+
+    EXPECT_FALSE(value.is_member("key"));
+    EXPECT_FALSE(value.is_member(key(count)));
+    EXPECT_TRUE(cvalue[key(count)].is_null());
+    EXPECT_EQ(value.size(), count);
+
+    unsigned i = 0;
+    for (auto it = value.cbegin(); it != value.cend(); ++it, ++i) {
+        EXPECT_EQ(it.key(), key(i));
+    }
+}
+
+TEST_F(ValueTest, PositiveMembersErase) {
+    const unsigned count = 100;
+    Value value;
+
+    for (unsigned i = 0; i < count; ++i) {
+        value.push_back(json::Pair(key(i), i));
+    }
+
+    for (unsigned i = 0; i < count; i += 2) {
+        EXPECT_EQ(value.erase(key(i)), 1u);
+    }
+    EXPECT_EQ(value.erase(key(0)), 0u);
+
+    ASSERT_EQ(value.size(), count / 2);
+    for (unsigned i = 0; i < count; ++i) {
+        EXPECT_EQ(value.is_member(key(i)), (1 == (i % 2)));
+    }
+
+    value.erase(value.begin());
+    EXPECT_FALSE(value.is_member(key(1)));
+    EXPECT_EQ(value[std::size_t(0)].as_uint(), 3u);
+
+    value.pop_back();
+    EXPECT_FALSE(value.is_member(key(count - 1)));
+
+    value[key(count - 1)] = 1;
+    EXPECT_EQ(value.size(), count / 2 - 1);
+    EXPECT_EQ(value[key(count - 1)].as_uint(), 1u);
+}
+
+TEST_F(ValueTest, PositiveMembersRangeErase) {
+    const unsigned count = 100;
+    Value value;
+    Value array;
+
+    for (unsigned i = 0; i < count; ++i) {
+        value[key(i)] = i;
+        array.push_back(i);
+    }
+
+    value.erase(value.cbegin() + 10, value.cbegin() + 90);
+    array.erase(array.cbegin() + 10, array.cbegin() + 90);
+
+    ASSERT_EQ(value.size(), 20u);
+    ASSERT_EQ(array.size(), 20u);
+    for (unsigned i = 0; i < count; ++i) {
+        const bool kept = (i < 10) || (i >= 90);
+        EXPECT_EQ(value.is_member(key(i)), kept);
+        if (kept) { EXPECT_EQ(value[key(i)].as_uint(), i); }
+    }
+    EXPECT_EQ(array[std::size_t(10)].as_uint(), 90u);
+}
+
+TEST_F(ValueTest, PositiveMembersPopBack) {
+    const unsigned count = 50000;
+    Value value;
+
+    for (unsigned i = 0; i < count; ++i) {
+        value[key(i)] = i;
+    }
+
+    for (unsigned i = count; i > 0; --i) {
+        if (0 == (i % 997)) {
+            EXPECT_EQ(value[key(i - 1)].as_uint(), i - 1);
+            EXPECT_EQ(value[key(i / 2)].as_uint(), i / 2);
+        }
+        value.pop_back();
+        EXPECT_FALSE(value.is_member(key(i - 1)));
+    }
+    EXPECT_TRUE(value.empty());
+}
+
+TEST_F(ValueTest, PositiveMembersEraseLarge) {
+    const unsigned count = 5000;
+    Value value;
+
+    for (unsigned i = 0; i < count; ++i) {
+        value[key(i)] = i;
+    }
+
+    /* Erase from the back and then every third of remaining members */
+    for (unsigned i = count; i > count / 2; --i) {
+        EXPECT_EQ(value.erase(key(i - 1)), 1u);
+    }
+    for (unsigned i = 0; i < count / 2; i += 3) {
+        EXPECT_EQ(value.erase(key(i)), 1u);
+    }
+
+    for (unsigned i = 0; i < count; ++i) {
+        const bool kept = (i < count / 2) && (0 != (i % 3));
+        ASSERT_EQ(value.is_member(key(i)), kept);
+        if (kept) { EXPECT_EQ(value[key(i)].as_uint(), i); }
+    }
+}
+
+TEST_F(ValueTest, PositiveMembersEraseDuplicated) {
+    std::string str{"{"};
+
+    for (unsigned i = 0; i < 32; ++i) {
+        str += "\"" + key(i) + "\":" + std::to_string(i) + ",";
+    }
+    str += "\"" + key(0) + "\":100}";
+
+    Value value;
+    str >> value;
+
+    EXPECT_EQ(value[key(0)].as_uint(), 0u);
+    value.erase(value.cbegin());
+    EXPECT_EQ(value[key(0)].as_uint(), 100u);
+    EXPECT_EQ(value[key(31)].as_uint(), 31u);
+}
+
+TEST_F(ValueTest, PositiveMembersRangeInsert) {
+    const unsigned count = 100;
+    Value value;
+    Value other;
+
+    for (unsigned i = 0; i < count; ++i) {
+        value[key(i)] = i;
+        other[key(i + count / 2)] = i + count;
+    }
+
+    value.insert(value.cbegin() + 1, other);
+
+    ASSERT_EQ(value.size(), count + count / 2);
+    EXPECT_EQ(value[std::size_t(1)].as_uint(), count + count / 2);
+    for (unsigned i = 0; i < count; ++i) {
+        EXPECT_EQ(value[key(i)].as_uint(), i);
+    }
+    for (unsigned i = count; i < count + count / 2; ++i) {
+        EXPECT_EQ(value[key(i)].as_uint(), i + count / 2);
+    }
+
+    Value objects{other, other};
+    Value result;
+    result[key(0)] = 0;
+    result.insert(result.cbegin(), objects.cbegin(), objects.cend());
+
+    ASSERT_EQ(result.size(), count + 1);
+    EXPECT_EQ(result[key(0)].as_uint(), 0u);
+    EXPECT_EQ(result[std::size_t(count)].as_uint(), 0u);
+
+    Value array{1, 2, 3};
+    array.insert(array.cbegin() + 1, array.cbegin(), array.cend());
+    EXPECT_EQ(array, (Value{1, 1, 2, 3, 2, 3}));
+}
+
+TEST_F(ValueTest, PositiveMembersCopy) {
+    Value value;
+
+    for (unsigned i = 0; i < 100; ++i) {
+        value[key(i)] = i;
+    }
+
+    Value copy = value;
+    Value moved = std::move(copy);
+    copy = moved;
+
+    value.clear();
+    EXPECT_FALSE(value.is_member(key(0)));
+
+    for (unsigned i = 0; i < 100; ++i) {
+        EXPECT_EQ(moved[key(i)].as_uint(), i);
+        EXPECT_EQ(copy[key(i)].as_uint(), i);
+    }
+
+    copy[key(100)] = 100;
+    EXPECT_FALSE(moved.is_member(key(100)));
+    EXPECT_EQ(moved, value = moved);
+}
+
+TEST_F(ValueTest, PositiveMembersParsed) {
+    std::string str{"{"};
+
+    for (unsigned i = 0; i < 100; ++i) {
+        str += "\"" + key(i) + "\":" + std::to_string(i) + ",";
+    }
+    str += "\"key0\":true}";
+
+    Value value;
+    json::Deserializer(str) >> value;
+
+    ASSERT_EQ(value.size(), 101u);
+    EXPECT_EQ(value["key0"].as_uint(), 0u);
+    EXPECT_EQ(value["key99"].as_uint(), 99u);
+
+    EXPECT_EQ(value.erase("key0"), 1u);
+    EXPECT_TRUE(value["key0"].as_bool());
+}
+
+TEST_F(ValueTest, PositiveCompactLayout) {
+    EXPECT_EQ(sizeof(Value), sizeof(json::Number));
+
+    Value value(5);
+    ASSERT_TRUE(value.is_int());
+    EXPECT_EQ(value.get_type(), Value::Type::NUMBER);
+
+    value.as_number() = json::Number(2.5);
+    EXPECT_TRUE(value.is_double());
+    EXPECT_TRUE(value.is_number());
+    EXPECT_DOUBLE_EQ(value.as_double(), 2.5);
+
+    value = "text";
+    EXPECT_TRUE(value.is_string());
+    EXPECT_FALSE(value.is_number());
+    value.as_string() += "s";
+    EXPECT_EQ(value.as_string(), "texts");
+
+    value = Value::Type::BOOLEAN;
+    EXPECT_TRUE(value.is_boolean());
+    EXPECT_FALSE(value.as_bool());
+
+    value = {1u, 2.0, "three", nullptr, true};
+    ASSERT_TRUE(value.is_array());
+    EXPECT_TRUE(value[0].is_uint());
+    EXPECT_TRUE(value[1].is_double());
+    EXPECT_TRUE(value[2].is_string());
+    EXPECT_TRUE(value[3].is_null());
+    EXPECT_TRUE(value[4].is_boolean());
+}
+
+TEST_F(ValueTest, PositiveCompactMove) {
+    Value value("key", Value{1, "two"});
+    const Value copy = value;
+
+    Value moved(std::move(value));
+    EXPECT_TRUE(value.is_null());
+    EXPECT_EQ(moved, copy);
+
+    value = std::move(moved);
+    EXPECT_TRUE(moved.is_null());
+    EXPECT_EQ(value, copy);
+
+    moved = 7;
+    moved = value;
+    EXPECT_EQ(moved, copy);
+    moved["key"][1] = 3;
+    EXPECT_EQ(value["key"][1].as_string(), "two");
+}
+
+TEST_F(ValueTest, PositiveMoveChildToParent) {
+    Value value;
+    value["a"]["b"] = 2;
+    value["a"]["c"] = 1;
+
+    value = std::move(value["a"]);
+    ASSERT_TRUE(value.is_object());
+    EXPECT_EQ(value["b"].as_int(), 2);
+    EXPECT_EQ(value["c"].as_int(), 1);
+
+    Value array{Value{1, "two"}, 3};
+
+    array = std::move(array[0]);
+    ASSERT_TRUE(array.is_array());
+    EXPECT_EQ(array[1].as_string(), "two");
+}